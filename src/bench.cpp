@@ -0,0 +1,281 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "flat_tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "dp_kernels.h"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+
+using std::cout;
+using std::endl;
+
+void printUsage(const std::string& errorMessage)
+{
+    cout << "Error: " << errorMessage << endl;
+    printf("Usage:\n"
+       "./bench [options]\n"
+       "\n"
+       "Description:\n"
+       "    Times the introduce, forget and join steps of MINIMUM_WEIGHT_VERTEX_COVER on dense tables and parsing, rooting\n"
+       "    and making nice random tree decompositions, for every bag size in a range. Each benchmark is repeated and\n"
+       "    reported as the mean and standard deviation of the nanoseconds per item and as the mean throughput.\n"
+       "\n"
+       "Options:\n"
+       "    --min-bag-size K         Smallest bag size (default: 4).\n"
+       "    --max-bag-size K         Largest bag size (default: 24).\n"
+       "    --repetitions R          Number of measurements per benchmark (default: 10).\n"
+       "    --nodes N                Number of bags of the random tree decompositions (default: 10000).\n"
+       "    --simd LEVEL             Runs the kernels as scalar, avx2 or avx512 instead of the widest supported version.\n"
+      );
+}
+
+struct BenchOptions {
+    size_t min_bag_size = 4;
+    size_t max_bag_size = 24;
+    size_t repetitions = 10;
+    size_t nodes = 10000;
+    std::optional<SimdLevel> simd_level;
+};
+
+bool parseArguments(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            printUsage("Unknown argument " + arg + ".");
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--simd") {
+            if (value == "scalar")
+                options.simd_level = SimdLevel::Scalar;
+            else if (value == "avx2")
+                options.simd_level = SimdLevel::AVX2;
+            else if (value == "avx512")
+                options.simd_level = SimdLevel::AVX512;
+            else {
+                printUsage("Unknown SIMD level " + value + ".");
+                return false;
+            }
+            continue;
+        }
+
+        size_t number;
+        try {
+            number = std::stoul(value);
+        }
+        catch (const std::exception&) {
+            printUsage(arg + " expects a number.");
+            return false;
+        }
+        if (arg == "--min-bag-size")
+            options.min_bag_size = number;
+        else if (arg == "--max-bag-size")
+            options.max_bag_size = number;
+        else if (arg == "--repetitions")
+            options.repetitions = number;
+        else if (arg == "--nodes")
+            options.nodes = number;
+        else {
+            printUsage("Unknown argument " + arg + ".");
+            return false;
+        }
+    }
+
+    // Bags of a single vertex have no introduce kernel to time, and masks have to fit into a `Cover_Mask`.
+    if (options.min_bag_size < 2 || options.min_bag_size > options.max_bag_size || options.max_bag_size >= 8 * sizeof(Cover_Mask)) {
+        printUsage("Bag sizes have to satisfy 2 <= min <= max < " + std::to_string(8 * sizeof(Cover_Mask)) + ".");
+        return false;
+    }
+    if (options.repetitions < 2 || options.nodes == 0) {
+        printUsage("At least 2 repetitions and 1 node are expected.");
+        return false;
+    }
+    return true;
+}
+
+template<typename F>
+double timeNs(F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printHeader() {
+    cout << std::left << std::setw(32) << "benchmark" << std::right << std::setw(5) << "bag" << std::setw(12) << "items"
+        << std::setw(12) << "ns/item" << std::setw(10) << "stddev" << std::setw(16) << "items/s" << std::setw(6) << "reps" << "  unit" << endl;
+}
+
+// Calls `sample` `repetitions` times, each returning the nanoseconds it spent on `items` items, and prints the mean and (sample) standard deviation of the time per item.
+template<typename Sample>
+void report(const std::string& name, size_t bag_size, size_t items, const std::string& unit, size_t repetitions, Sample&& sample) {
+    std::vector<double> ns_per_item;
+    for (size_t i = 0; i < repetitions; i++)
+        ns_per_item.push_back(sample() / items);
+
+    double mean = 0.0;
+    for (const double ns : ns_per_item)
+        mean += ns / repetitions;
+    double variance = 0.0;
+    for (const double ns : ns_per_item)
+        variance += (ns - mean) * (ns - mean) / (repetitions - 1);
+
+    cout << std::left << std::setw(32) << name << std::right << std::setw(5) << bag_size << std::setw(12) << items
+        << std::setw(12) << std::setprecision(4) << mean
+        << std::setw(9) << std::setprecision(2) << std::fixed << 100.0 * std::sqrt(variance) / mean << "%" << std::defaultfloat
+        << std::setw(16) << std::setprecision(4) << 1e9 / mean << std::setw(6) << repetitions << "  " << unit << endl;
+}
+
+// Repeats `run` within a sample until the sample takes at least 10 ms, so that small tables are not dominated by the clock. Returns the nanoseconds of one run.
+template<typename Run>
+auto kernelSample(Run&& run) {
+    const double first_ns = std::max(timeNs(run), 1.0);
+    const size_t iterations = std::max<size_t>(1, static_cast<size_t>(1e7 / first_ns));
+    return [run, iterations]() {
+        return timeNs([&run, iterations]() {
+            for (size_t i = 0; i < iterations; i++)
+                run();
+        }) / iterations;
+    };
+}
+
+// Random table entries, one in eight of them invalid.
+std::vector<Vertex_Cover_Weight> randomTable(size_t size, std::mt19937& rng) {
+    std::uniform_int_distribution<Vertex_Cover_Weight> weight(0, 999);
+    std::vector<Vertex_Cover_Weight> table(size);
+    for (Vertex_Cover_Weight& entry : table)
+        entry = rng() % 8 == 0 ? INVALID_COVER : weight(rng);
+    return table;
+}
+
+// Table entries are those of the larger table: the parent's for introduce and join nodes, the child's for forget nodes.
+void benchKernels(size_t bag_size, size_t repetitions) {
+    std::mt19937 rng(bag_size);
+    const size_t size = size_t{1} << bag_size;
+    const size_t pos = bag_size / 2;
+
+    {
+        const std::vector<Vertex_Cover_Weight> child = randomTable(size / 2, rng);
+        std::vector<Vertex_Cover_Weight> out(size);
+        const Cover_Mask neighbour_mask = Cover_Mask{0x5555555555555555} & (size / 2 - 1);
+        report("introduce", bag_size, size, "table entries", repetitions, kernelSample([&]() {
+            VertexCoverProblem::introduce(child.data(), out.data(), size / 2, pos, neighbour_mask, 3);
+        }));
+    }
+    {
+        const std::vector<Vertex_Cover_Weight> child = randomTable(size, rng);
+        std::vector<Vertex_Cover_Weight> out(size / 2);
+        // The DP zeroes the choices once per table, the kernel only sets bits.
+        std::vector<uint64_t> choices((size / 2 + 63) / 64, 0);
+        report("forget", bag_size, size, "table entries", repetitions, kernelSample([&]() {
+            VertexCoverProblem::forget(child.data(), out.data(), choices.data(), size / 2, pos);
+        }));
+    }
+    {
+        const std::vector<Vertex_Cover_Weight> left = randomTable(size, rng);
+        const std::vector<Vertex_Cover_Weight> right = randomTable(size, rng);
+        std::vector<Vertex_Cover_Weight> out(size);
+        std::vector<Vertex_Weight> bag_weights(bag_size);
+        for (Vertex_Weight& weight : bag_weights)
+            weight = 1 + rng() % 100;
+        report("join", bag_size, size, "table entries", repetitions, kernelSample([&]() {
+            VertexCoverProblem::join(left.data(), right.data(), out.data(), size, bag_weights);
+        }));
+    }
+}
+
+/*
+Writes a random (bag_size - 1)-tree with `nodes` bags in the CSV format: The first bag is a clique, every further bag replaces a random vertex of a random earlier bag by a new vertex adjacent to the rest of that bag. Thus all bags have `bag_size` vertices, and the tree decomposition branches like a random recursive tree.
+Returns the total size of all bags.
+*/
+size_t writeRandomKTree(size_t bag_size, size_t nodes, const std::filesystem::path& graph_path, const std::filesystem::path& td_path) {
+    std::mt19937 rng(bag_size);
+    std::ofstream graph_file{graph_path};
+    std::ofstream td_file{td_path};
+
+    std::vector<std::vector<size_t>> bags{{}};
+    for (size_t v = 0; v < bag_size; v++) {
+        for (const size_t u : bags[0])
+            graph_file << u << "," << v << "\n";
+        bags[0].push_back(v);
+    }
+    for (size_t n = 1; n < nodes; n++) {
+        const size_t parent = rng() % n;
+        std::vector<size_t> bag = bags[parent];
+        const size_t v = bag_size + n - 1;
+        bag[rng() % bag_size] = v;
+        for (const size_t u : bag) {
+            if (u != v)
+                graph_file << u << "," << v << "\n";
+        }
+        td_file << parent << "," << n << "\n";
+        bags.push_back(std::move(bag));
+    }
+    for (size_t v = 0; v < bag_size + nodes - 1; v++)
+        graph_file << v << ",," << 1 + rng() % 100 << "\n";
+
+    for (size_t n = 0; n < nodes; n++) {
+        td_file << n << ",,";
+        for (size_t i = 0; i < bag_size; i++)
+            td_file << bags[n][i] << (i + 1 < bag_size ? ";" : "\n");
+    }
+    return nodes * bag_size;
+}
+
+// Bag entries are those of the given tree decomposition, also for the nice tree decompositions built from it.
+void benchTreeDecompositions(size_t bag_size, size_t nodes, size_t repetitions) {
+    const std::filesystem::path graph_path = std::filesystem::temp_directory_path() / ("bench_" + std::to_string(bag_size) + ".gr.csv");
+    const std::filesystem::path td_path = std::filesystem::temp_directory_path() / ("bench_" + std::to_string(bag_size) + ".td.csv");
+    const size_t bag_entries = writeRandomKTree(bag_size, nodes, graph_path, td_path);
+
+    report("UndirectedGraph::parseUnsafe", bag_size, std::filesystem::file_size(graph_path), "bytes", repetitions, [&]() {
+        std::optional<UndirectedGraph> graph;
+        return timeNs([&]() { graph.emplace(UndirectedGraph::parseUnsafe(graph_path)); });
+    });
+
+    const UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+    report("TreeDecomposition::parseUnsafe", bag_size, std::filesystem::file_size(td_path), "bytes", repetitions, [&]() {
+        std::optional<TreeDecomposition> td;
+        return timeNs([&]() { td.emplace(TreeDecomposition::parseUnsafe(td_path, graph)); });
+    });
+
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+    std::filesystem::remove(graph_path);
+    std::filesystem::remove(td_path);
+
+    report("rootTree", bag_size, bag_entries, "bag entries", repetitions, [&]() {
+        return timeNs([&]() { td.rootTree(); });
+    });
+    report("turnIntoNiceTreeDecomposition", bag_size, bag_entries, "bag entries", repetitions, [&]() {
+        TreeDecomposition nice_td = td;
+        return timeNs([&]() { nice_td.turnIntoNiceTreeDecomposition(); });
+    });
+    report("FlatTreeDecomposition::nice", bag_size, bag_entries, "bag entries", repetitions, [&]() {
+        std::optional<FlatTreeDecomposition> flat_td;
+        return timeNs([&]() { flat_td.emplace(FlatTreeDecomposition::nice(td)); });
+    });
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options))
+        return 1;
+
+    if (options.simd_level.has_value() && !setSimdLevel(options.simd_level.value())) {
+        cout << "The CPU does not support " << simdLevelName(options.simd_level.value()) << " kernels." << endl;
+        return 1;
+    }
+    cout << "Using " << simdLevelName(getSimdLevel()) << " kernels." << endl;
+
+    printHeader();
+    for (size_t bag_size = options.min_bag_size; bag_size <= options.max_bag_size; bag_size++)
+        benchKernels(bag_size, options.repetitions);
+    for (size_t bag_size = options.min_bag_size; bag_size <= options.max_bag_size; bag_size++)
+        benchTreeDecompositions(bag_size, options.nodes, options.repetitions);
+}
@@ -0,0 +1,381 @@
+#include "dp_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DP_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+//// Scalar kernels ////
+
+// Joins one block of `forEachSubsetWeightBlock`, whose subset weights are low_weights[U] + high_weight.
+static void joinKernelScalar(const Vertex_Cover_Weight* left, const Vertex_Cover_Weight* right, const Vertex_Cover_Weight* low_weights, Vertex_Cover_Weight high_weight, Vertex_Cover_Weight* out, size_t size) {
+    for (size_t U = 0; U < size; U++) {
+        if (left[U] == INVALID_COVER || right[U] == INVALID_COVER)
+            out[U] = INVALID_COVER;
+        else
+            out[U] = left[U] + right[U] - (low_weights[U] + high_weight);
+    }
+}
+
+static void introduceKernelScalar(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Cover_Weight v_weight, size_t start = 0) {
+    const size_t low_mask = (size_t{1} << pos) - 1;
+    for (Cover_Mask U = start; U < 2 * child_size; U++) {
+        const Cover_Mask U_prime = ((U >> (pos + 1)) << pos) | (U & low_mask);
+        const Vertex_Cover_Weight weight = child[U_prime];
+        if (U >> pos & 1)
+            out[U] = weight == INVALID_COVER ? INVALID_COVER : weight + v_weight;
+        else
+            out[U] = (U_prime & neighbour_mask) == neighbour_mask ? weight : INVALID_COVER;
+    }
+}
+
+static void forgetKernelScalar(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, uint64_t* choices, size_t out_size, size_t pos, size_t start = 0) {
+    const size_t low_mask = (size_t{1} << pos) - 1;
+    for (Cover_Mask U = start; U < out_size; U++) {
+        const Cover_Mask without_v = ((U >> pos) << (pos + 1)) | (U & low_mask);
+        const Vertex_Cover_Weight weight_without_v = child[without_v];
+        const Vertex_Cover_Weight weight_with_v = child[without_v | (low_mask + 1)];
+        if (weight_with_v < weight_without_v) {
+            out[U] = weight_with_v;
+            choices[U >> 6] |= uint64_t{1} << (U & 63);
+        }
+        else {
+            out[U] = weight_without_v;
+        }
+    }
+}
+
+//// AVX2 kernels ////
+
+#ifdef DP_KERNELS_X86
+__attribute__((target("avx2")))
+static void joinKernelAVX2(const Vertex_Cover_Weight* left, const Vertex_Cover_Weight* right, const Vertex_Cover_Weight* low_weights, Vertex_Cover_Weight high_weight, Vertex_Cover_Weight* out, size_t size) {
+    const __m256i invalid = _mm256_set1_epi32(INVALID_COVER);
+    const __m256i high = _mm256_set1_epi32(high_weight);
+    size_t U = 0;
+    for (; U + 8 <= size; U += 8) {
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + U));
+        const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + U));
+        const __m256i w = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(low_weights + U)), high);
+        const __m256i is_invalid = _mm256_or_si256(_mm256_cmpeq_epi32(l, invalid), _mm256_cmpeq_epi32(r, invalid));
+        const __m256i sum = _mm256_sub_epi32(_mm256_add_epi32(l, r), w);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + U), _mm256_blendv_epi8(sum, invalid, is_invalid));
+    }
+    joinKernelScalar(left + U, right + U, low_weights + U, high_weight, out + U, size - U);
+}
+
+/*
+If a block of 2^pos consecutive entries spans at least a full vector, the entries of a vector map to consecutive child entries and can be loaded directly. Otherwise the child indices are computed per lane and gathered.
+*/
+__attribute__((target("avx2")))
+static void introduceKernelAVX2(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Cover_Weight v_weight) {
+    const size_t block = size_t{1} << pos;
+    const __m256i invalid = _mm256_set1_epi32(INVALID_COVER);
+    const __m256i weight = _mm256_set1_epi32(v_weight);
+    const __m256i neighbours = _mm256_set1_epi32(neighbour_mask);
+    const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    if (block >= 8) {
+        for (size_t high = 0; high < child_size; high += block) {
+            for (size_t low = 0; low < block; low += 8) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(child + high + low));
+                const __m256i U_prime = _mm256_add_epi32(_mm256_set1_epi32(high + low), iota);
+                const __m256i neighbours_in_cover = _mm256_cmpeq_epi32(_mm256_and_si256(U_prime, neighbours), neighbours);
+                const __m256i with_v = _mm256_blendv_epi8(_mm256_add_epi32(v, weight), invalid, _mm256_cmpeq_epi32(v, invalid));
+                const __m256i without_v = _mm256_blendv_epi8(invalid, v, neighbours_in_cover);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * high + low), without_v);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * high + block + low), with_v);
+            }
+        }
+        return;
+    }
+
+    const __m128i shift_pos = _mm_cvtsi32_si128(pos);
+    const __m128i shift_pos_1 = _mm_cvtsi32_si128(pos + 1);
+    const __m256i low_mask = _mm256_set1_epi32(block - 1);
+    const __m256i block_bit = _mm256_set1_epi32(block);
+    size_t U = 0;
+    for (; U + 8 <= 2 * child_size; U += 8) {
+        const __m256i Us = _mm256_add_epi32(_mm256_set1_epi32(U), iota);
+        const __m256i U_prime = _mm256_or_si256(_mm256_sll_epi32(_mm256_srl_epi32(Us, shift_pos_1), shift_pos), _mm256_and_si256(Us, low_mask));
+        const __m256i v = _mm256_i32gather_epi32(child, U_prime, 4);
+        const __m256i contains_v = _mm256_cmpeq_epi32(_mm256_and_si256(Us, block_bit), block_bit);
+        const __m256i neighbours_in_cover = _mm256_cmpeq_epi32(_mm256_and_si256(U_prime, neighbours), neighbours);
+        const __m256i with_v = _mm256_blendv_epi8(_mm256_add_epi32(v, weight), invalid, _mm256_cmpeq_epi32(v, invalid));
+        const __m256i without_v = _mm256_blendv_epi8(invalid, v, neighbours_in_cover);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + U), _mm256_blendv_epi8(without_v, with_v, contains_v));
+    }
+    introduceKernelScalar(child, out, child_size, pos, neighbour_mask, v_weight, U);
+}
+
+__attribute__((target("avx2")))
+static void forgetKernelAVX2(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, uint64_t* choices, size_t out_size, size_t pos) {
+    const size_t block = size_t{1} << pos;
+
+    if (block >= 8) {
+        for (size_t high = 0; high < out_size; high += block) {
+            for (size_t low = 0; low < block; low += 8) {
+                const Cover_Mask U = high + low;
+                const __m256i without_v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(child + 2 * high + low));
+                const __m256i with_v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(child + 2 * high + block + low));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + U), _mm256_min_epi32(without_v, with_v));
+                const uint64_t better = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(without_v, with_v)));
+                choices[U >> 6] |= better << (U & 63);
+            }
+        }
+        return;
+    }
+
+    const __m128i shift_pos = _mm_cvtsi32_si128(pos);
+    const __m128i shift_pos_1 = _mm_cvtsi32_si128(pos + 1);
+    const __m256i low_mask = _mm256_set1_epi32(block - 1);
+    const __m256i block_bit = _mm256_set1_epi32(block);
+    const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    size_t U = 0;
+    for (; U + 8 <= out_size; U += 8) {
+        const __m256i Us = _mm256_add_epi32(_mm256_set1_epi32(U), iota);
+        const __m256i index_without_v = _mm256_or_si256(_mm256_sll_epi32(_mm256_srl_epi32(Us, shift_pos), shift_pos_1), _mm256_and_si256(Us, low_mask));
+        const __m256i without_v = _mm256_i32gather_epi32(child, index_without_v, 4);
+        const __m256i with_v = _mm256_i32gather_epi32(child, _mm256_or_si256(index_without_v, block_bit), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + U), _mm256_min_epi32(without_v, with_v));
+        const uint64_t better = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(without_v, with_v)));
+        choices[U >> 6] |= better << (U & 63);
+    }
+    forgetKernelScalar(child, out, choices, out_size, pos, U);
+}
+
+//// AVX-512 kernels ////
+
+__attribute__((target("avx512f")))
+static void joinKernelAVX512(const Vertex_Cover_Weight* left, const Vertex_Cover_Weight* right, const Vertex_Cover_Weight* low_weights, Vertex_Cover_Weight high_weight, Vertex_Cover_Weight* out, size_t size) {
+    const __m512i invalid = _mm512_set1_epi32(INVALID_COVER);
+    const __m512i high = _mm512_set1_epi32(high_weight);
+    size_t U = 0;
+    for (; U + 16 <= size; U += 16) {
+        const __m512i l = _mm512_loadu_si512(left + U);
+        const __m512i r = _mm512_loadu_si512(right + U);
+        const __m512i w = _mm512_add_epi32(_mm512_loadu_si512(low_weights + U), high);
+        const __mmask16 is_invalid = _mm512_cmpeq_epi32_mask(l, invalid) | _mm512_cmpeq_epi32_mask(r, invalid);
+        const __m512i sum = _mm512_sub_epi32(_mm512_add_epi32(l, r), w);
+        _mm512_storeu_si512(out + U, _mm512_mask_mov_epi32(sum, is_invalid, invalid));
+    }
+    joinKernelScalar(left + U, right + U, low_weights + U, high_weight, out + U, size - U);
+}
+
+__attribute__((target("avx512f")))
+static void introduceKernelAVX512(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Cover_Weight v_weight) {
+    const size_t block = size_t{1} << pos;
+    const __m512i invalid = _mm512_set1_epi32(INVALID_COVER);
+    const __m512i weight = _mm512_set1_epi32(v_weight);
+    const __m512i neighbours = _mm512_set1_epi32(neighbour_mask);
+    const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    if (block >= 16) {
+        for (size_t high = 0; high < child_size; high += block) {
+            for (size_t low = 0; low < block; low += 16) {
+                const __m512i v = _mm512_loadu_si512(child + high + low);
+                const __m512i U_prime = _mm512_add_epi32(_mm512_set1_epi32(high + low), iota);
+                const __mmask16 neighbours_in_cover = _mm512_cmpeq_epi32_mask(_mm512_and_si512(U_prime, neighbours), neighbours);
+                const __m512i with_v = _mm512_mask_mov_epi32(_mm512_add_epi32(v, weight), _mm512_cmpeq_epi32_mask(v, invalid), invalid);
+                const __m512i without_v = _mm512_mask_mov_epi32(invalid, neighbours_in_cover, v);
+                _mm512_storeu_si512(out + 2 * high + low, without_v);
+                _mm512_storeu_si512(out + 2 * high + block + low, with_v);
+            }
+        }
+        return;
+    }
+
+    const __m512i low_mask = _mm512_set1_epi32(block - 1);
+    const __m512i block_bit = _mm512_set1_epi32(block);
+    size_t U = 0;
+    for (; U + 16 <= 2 * child_size; U += 16) {
+        const __m512i Us = _mm512_add_epi32(_mm512_set1_epi32(U), iota);
+        const __m512i U_prime = _mm512_or_si512(_mm512_slli_epi32(_mm512_srli_epi32(Us, pos + 1), pos), _mm512_and_si512(Us, low_mask));
+        const __m512i v = _mm512_i32gather_epi32(U_prime, child, 4);
+        const __mmask16 contains_v = _mm512_test_epi32_mask(Us, block_bit);
+        const __mmask16 neighbours_in_cover = _mm512_cmpeq_epi32_mask(_mm512_and_si512(U_prime, neighbours), neighbours);
+        const __m512i with_v = _mm512_mask_mov_epi32(_mm512_add_epi32(v, weight), _mm512_cmpeq_epi32_mask(v, invalid), invalid);
+        const __m512i without_v = _mm512_mask_mov_epi32(invalid, neighbours_in_cover, v);
+        _mm512_storeu_si512(out + U, _mm512_mask_mov_epi32(without_v, contains_v, with_v));
+    }
+    introduceKernelScalar(child, out, child_size, pos, neighbour_mask, v_weight, U);
+}
+
+__attribute__((target("avx512f")))
+static void forgetKernelAVX512(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, uint64_t* choices, size_t out_size, size_t pos) {
+    const size_t block = size_t{1} << pos;
+
+    if (block >= 16) {
+        for (size_t high = 0; high < out_size; high += block) {
+            for (size_t low = 0; low < block; low += 16) {
+                const Cover_Mask U = high + low;
+                const __m512i without_v = _mm512_loadu_si512(child + 2 * high + low);
+                const __m512i with_v = _mm512_loadu_si512(child + 2 * high + block + low);
+                _mm512_storeu_si512(out + U, _mm512_min_epi32(without_v, with_v));
+                const uint64_t better = _mm512_cmpgt_epi32_mask(without_v, with_v);
+                choices[U >> 6] |= better << (U & 63);
+            }
+        }
+        return;
+    }
+
+    const __m512i low_mask = _mm512_set1_epi32(block - 1);
+    const __m512i block_bit = _mm512_set1_epi32(block);
+    const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    size_t U = 0;
+    for (; U + 16 <= out_size; U += 16) {
+        const __m512i Us = _mm512_add_epi32(_mm512_set1_epi32(U), iota);
+        const __m512i index_without_v = _mm512_or_si512(_mm512_slli_epi32(_mm512_srli_epi32(Us, pos), pos + 1), _mm512_and_si512(Us, low_mask));
+        const __m512i without_v = _mm512_i32gather_epi32(index_without_v, child, 4);
+        const __m512i with_v = _mm512_i32gather_epi32(_mm512_or_si512(index_without_v, block_bit), child, 4);
+        _mm512_storeu_si512(out + U, _mm512_min_epi32(without_v, with_v));
+        const uint64_t better = _mm512_cmpgt_epi32_mask(without_v, with_v);
+        choices[U >> 6] |= better << (U & 63);
+    }
+    forgetKernelScalar(child, out, choices, out_size, pos, U);
+}
+#endif
+
+//// Dispatch ////
+
+static bool isSupported(SimdLevel level) {
+#ifdef DP_KERNELS_X86
+    // Required since this may run during static initialization.
+    __builtin_cpu_init();
+#endif
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+#ifdef DP_KERNELS_X86
+    case SimdLevel::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case SimdLevel::AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+SimdLevel detectSimdLevel() {
+    for (SimdLevel level : {SimdLevel::AVX512, SimdLevel::AVX2}) {
+        if (isSupported(level))
+            return level;
+    }
+    return SimdLevel::Scalar;
+}
+
+static SimdLevel simd_level = detectSimdLevel();
+
+SimdLevel getSimdLevel() {
+    return simd_level;
+}
+
+bool setSimdLevel(SimdLevel level) {
+    if (!isSupported(level))
+        return false;
+    simd_level = level;
+    return true;
+}
+
+std::string simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX2:
+        return "AVX2";
+    case SimdLevel::AVX512:
+        return "AVX-512";
+    default:
+        return "scalar";
+    }
+}
+
+void computeSubsetWeights(const std::vector<Vertex_Cover_Weight>& bag_weights, std::vector<Vertex_Cover_Weight>& subset_weights) {
+    subset_weights.resize(size_t{1} << bag_weights.size());
+    subset_weights[0] = 0;
+    // The subsets with highest bit i are exactly the subsets below bit i plus vertex i.
+    for (size_t i = 0; i < bag_weights.size(); i++) {
+        const size_t half = size_t{1} << i;
+        for (Cover_Mask U = 0; U < half; U++)
+            subset_weights[half + U] = subset_weights[U] + bag_weights[i];
+    }
+}
+
+void joinKernel(const Vertex_Cover_Weight* left, const Vertex_Cover_Weight* right, const std::vector<Vertex_Cover_Weight>& bag_weights, Vertex_Cover_Weight* out, size_t size) {
+    auto join_block = joinKernelScalar;
+#ifdef DP_KERNELS_X86
+    if (simd_level == SimdLevel::AVX512)
+        join_block = joinKernelAVX512;
+    else if (simd_level == SimdLevel::AVX2)
+        join_block = joinKernelAVX2;
+#endif
+    forEachSubsetWeightBlock(bag_weights, size, [&](size_t start, size_t block_size, const Vertex_Cover_Weight* low_weights, Vertex_Cover_Weight high_weight) {
+        join_block(left + start, right + start, low_weights, high_weight, out + start, block_size);
+    });
+}
+
+void introduceKernel(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Cover_Weight v_weight) {
+    switch (simd_level) {
+#ifdef DP_KERNELS_X86
+    case SimdLevel::AVX512:
+        return introduceKernelAVX512(child, out, child_size, pos, neighbour_mask, v_weight);
+    case SimdLevel::AVX2:
+        return introduceKernelAVX2(child, out, child_size, pos, neighbour_mask, v_weight);
+#endif
+    default:
+        return introduceKernelScalar(child, out, child_size, pos, neighbour_mask, v_weight);
+    }
+}
+
+void forgetKernel(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, uint64_t* choices, size_t out_size, size_t pos) {
+    switch (simd_level) {
+#ifdef DP_KERNELS_X86
+    case SimdLevel::AVX512:
+        return forgetKernelAVX512(child, out, choices, out_size, pos);
+    case SimdLevel::AVX2:
+        return forgetKernelAVX2(child, out, choices, out_size, pos);
+#endif
+    default:
+        return forgetKernelScalar(child, out, choices, out_size, pos);
+    }
+}
+
+BitProjection::BitProjection(size_t num_bits, const std::vector<size_t>& positions) : low_bits(num_bits / 2) {
+    auto build_table = [&positions](size_t first_bit, size_t bits) {
+        std::vector<Cover_Mask> table(size_t{1} << bits, 0);
+        for (size_t j = 0; j < positions.size(); j++) {
+            if (positions[j] < first_bit || positions[j] >= first_bit + bits)
+                continue;
+            const Cover_Mask input_bit = Cover_Mask{1} << (positions[j] - first_bit);
+            for (Cover_Mask mask = 0; mask < table.size(); mask++) {
+                if (mask & input_bit)
+                    table[mask] |= Cover_Mask{1} << j;
+            }
+        }
+        return table;
+    };
+    low = build_table(0, low_bits);
+    high = build_table(low_bits, num_bits - low_bits);
+}
+
+void forgetManyKernel(const Vertex_Cover_Weight* child, size_t child_size, const BitProjection& to_common, const BitProjection& to_forgotten, Vertex_Cover_Weight* acc, uint32_t* choices) {
+    for (Cover_Mask U_prime = 0; U_prime < child_size; U_prime++) {
+        const Cover_Mask key = to_common(U_prime);
+        if (child[U_prime] < acc[key]) {
+            acc[key] = child[U_prime];
+            choices[key] = to_forgotten(U_prime);
+        }
+    }
+}
+
+void introduceManyKernel(const Vertex_Cover_Weight* acc, Vertex_Cover_Weight* out, size_t out_size, const BitProjection& to_common, const BitProjection& to_introduced, const Vertex_Cover_Weight* introduced_weights, const std::vector<Cover_Mask>& introduced_neighbour_masks) {
+    for (Cover_Mask U = 0; U < out_size; U++) {
+        const Vertex_Cover_Weight weight = acc[to_common(U)];
+        const Cover_Mask introduced = to_introduced(U);
+        bool is_vertex_cover = weight != INVALID_COVER;
+        for (size_t i = 0; is_vertex_cover && i < introduced_neighbour_masks.size(); i++) {
+            if (!(introduced >> i & 1))
+                is_vertex_cover = (U & introduced_neighbour_masks[i]) == introduced_neighbour_masks[i];
+        }
+        out[U] = is_vertex_cover ? weight + introduced_weights[introduced] : INVALID_COVER;
+    }
+}
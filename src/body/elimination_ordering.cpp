@@ -0,0 +1,112 @@
+#include "elimination_ordering.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+
+EliminationHeuristic parseEliminationHeuristic(const std::string& name) {
+    if (name == "min-degree")
+        return EliminationHeuristic::MinDegree;
+    if (name == "min-fill")
+        return EliminationHeuristic::MinFill;
+    throw std::invalid_argument("Unknown elimination heuristic " + name + ".");
+}
+
+/*
+The graph is eliminated in place. For min-fill, the fill-in of every vertex (the number of non-adjacent pairs among its neighbours) is kept up to date incrementally: Removing a vertex and adding a single edge only change the fill-in of the endpoints' neighbourhoods, so eliminating v costs O(sum of the degrees of v's neighbours) per fill edge instead of recomputing all fill-ins from scratch.
+Candidates are kept in an ordered set keyed by (fill-in, degree, id), which is re-keyed for every vertex whose key changed.
+*/
+std::vector<Vertex_Id> computeEliminationOrdering(const UndirectedGraph& graph, EliminationHeuristic heuristic) {
+    const std::vector<Vertex_Id>& vertices = graph.getVertices();
+    const size_t number_of_ids = vertices.empty() ? 0 : *std::max_element(vertices.begin(), vertices.end()) + 1;
+    const bool track_fill = heuristic == EliminationHeuristic::MinFill;
+
+    std::vector<std::unordered_set<Vertex_Id>> neighbours(number_of_ids);
+    for (const Vertex_Id v_id : vertices) {
+        for (const Vertex_Id u_id : graph.getNeighbours(v_id)) {
+            if (u_id != v_id)
+                neighbours[v_id].insert(u_id);
+        }
+    }
+
+    std::vector<size_t> fill(number_of_ids, 0);
+    if (track_fill) {
+        for (const Vertex_Id v_id : vertices) {
+            const std::vector<Vertex_Id> N{neighbours[v_id].begin(), neighbours[v_id].end()};
+            for (size_t i = 0; i < N.size(); i++) {
+                for (size_t j = i + 1; j < N.size(); j++)
+                    fill[v_id] += !neighbours[N[i]].contains(N[j]);
+            }
+        }
+    }
+
+    using Key = std::tuple<size_t, size_t, Vertex_Id>;
+    auto key = [&fill, &neighbours](Vertex_Id v_id) { return Key{fill[v_id], neighbours[v_id].size(), v_id}; };
+
+    std::set<Key> candidates;
+    std::vector<Key> current_key(number_of_ids);
+    for (const Vertex_Id v_id : vertices) {
+        current_key[v_id] = key(v_id);
+        candidates.insert(current_key[v_id]);
+    }
+
+    std::vector<Vertex_Id> ordering;
+    ordering.reserve(vertices.size());
+    std::unordered_set<Vertex_Id> touched;
+
+    while (!candidates.empty()) {
+        const Vertex_Id v_id = std::get<2>(*candidates.begin());
+        candidates.erase(candidates.begin());
+        ordering.push_back(v_id);
+
+        const std::vector<Vertex_Id> N{neighbours[v_id].begin(), neighbours[v_id].end()};
+        touched.clear();
+
+        // Remove v: Pairs of v with vertices it is not adjacent to no longer count towards its neighbours' fill-in.
+        for (const Vertex_Id u_id : N) {
+            neighbours[u_id].erase(v_id);
+            touched.insert(u_id);
+            if (track_fill) {
+                for (const Vertex_Id w_id : neighbours[u_id])
+                    fill[u_id] -= !neighbours[v_id].contains(w_id);
+            }
+        }
+        neighbours[v_id].clear();
+
+        // Turn the former neighbours of v into a clique.
+        for (size_t i = 0; i < N.size(); i++) {
+            for (size_t j = i + 1; j < N.size(); j++) {
+                const Vertex_Id x_id = N[i];
+                const Vertex_Id y_id = N[j];
+                if (neighbours[x_id].contains(y_id))
+                    continue;
+
+                if (track_fill) {
+                    const Vertex_Id smaller = neighbours[x_id].size() <= neighbours[y_id].size() ? x_id : y_id;
+                    const Vertex_Id larger = smaller == x_id ? y_id : x_id;
+                    for (const Vertex_Id z_id : neighbours[smaller]) {
+                        if (neighbours[larger].contains(z_id)) {
+                            fill[z_id]--;
+                            touched.insert(z_id);
+                        }
+                    }
+                    for (const Vertex_Id w_id : neighbours[x_id])
+                        fill[x_id] += !neighbours[y_id].contains(w_id);
+                    for (const Vertex_Id w_id : neighbours[y_id])
+                        fill[y_id] += !neighbours[x_id].contains(w_id);
+                }
+                neighbours[x_id].insert(y_id);
+                neighbours[y_id].insert(x_id);
+            }
+        }
+
+        for (const Vertex_Id u_id : touched) {
+            candidates.erase(current_key[u_id]);
+            current_key[u_id] = key(u_id);
+            candidates.insert(current_key[u_id]);
+        }
+    }
+
+    return ordering;
+}
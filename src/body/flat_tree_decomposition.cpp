@@ -0,0 +1,224 @@
+#include "flat_tree_decomposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+// A node's children keep the order of `Node::children`.
+FlatTreeDecomposition::FlatTreeDecomposition(const TreeDecomposition& td) {
+    if (!td.isRooted())
+        throw std::invalid_argument("Only rooted tree decompositions can be flattened.");
+    root = td.getRoot();
+    td.doSomethingPreOrder([this](Node_Id n_id) { pre_order.push_back(n_id); });
+
+    const size_t id_bound = *std::max_element(pre_order.begin(), pre_order.end()) + 1;
+    parents.assign(id_bound, NO_NODE);
+    child_offsets.assign(id_bound + 1, 0);
+    bag_offsets.assign(id_bound + 1, 0);
+    for (const Node_Id n_id : pre_order) {
+        const Node& node = td.getNode(n_id);
+        child_offsets[n_id + 1] = node.children.size();
+        bag_offsets[n_id + 1] = node.bag.size();
+    }
+    for (size_t n_id = 0; n_id < id_bound; n_id++) {
+        child_offsets[n_id + 1] += child_offsets[n_id];
+        bag_offsets[n_id + 1] += bag_offsets[n_id];
+    }
+
+    children.resize(child_offsets.back());
+    bags.resize(bag_offsets.back());
+    for (const Node_Id n_id : pre_order) {
+        const Node& node = td.getNode(n_id);
+        std::copy(node.children.begin(), node.children.end(), children.begin() + child_offsets[n_id]);
+        for (const Node_Id child_id : node.children)
+            parents[child_id] = n_id;
+        std::copy(node.bag.begin(), node.bag.end(), bags.begin() + bag_offsets[n_id]);
+        std::sort(bags.begin() + bag_offsets[n_id], bags.begin() + bag_offsets[n_id + 1]);
+    }
+}
+
+FlatTreeDecomposition FlatTreeDecomposition::nice(const TreeDecomposition& td, JoinTreeShape join_tree_shape) {
+    if (!td.isRooted())
+        throw std::invalid_argument("Only rooted tree decompositions can be made nice.");
+
+    // The join trees of the weighted shape need the cost of every subtree of `td`.
+    std::unordered_map<Node_Id, double> subtree_costs;
+    if (join_tree_shape == JoinTreeShape::Weighted) {
+        td.doSomethingPostOrder([&td, &subtree_costs](Node_Id n_id) {
+            const Node& node = td.getNode(n_id);
+            double cost = std::ldexp(1.0, node.bag.size());
+            for (const Node_Id child_id : node.children)
+                cost += subtree_costs.at(child_id);
+            subtree_costs[n_id] = cost;
+        });
+    }
+
+    FlatTreeDecomposition flat_td;
+    flat_td.bag_offsets.push_back(0);
+    // `bag` must not point into `flat_td.bags`.
+    auto addNode = [&flat_td](Node_Id parent_id, const std::vector<Vertex_Id>& bag) {
+        flat_td.parents.push_back(parent_id);
+        flat_td.bags.insert(flat_td.bags.end(), bag.begin(), bag.end());
+        flat_td.bag_offsets.push_back(flat_td.bags.size());
+        return flat_td.parents.size() - 1;
+    };
+
+    // Each task builds the subtree of a node of `td` below a new node, which still has no children.
+    std::vector<std::pair<Node_Id, Node_Id>> tasks{{td.getRoot(), NO_NODE}};
+    std::vector<Vertex_Id> bag;
+    std::vector<Vertex_Id> cur_bag;
+    std::vector<Vertex_Id> only_in_parent;
+    std::vector<Vertex_Id> only_in_child;
+    while (!tasks.empty()) {
+        const auto [original_id, parent_id] = tasks.back();
+        tasks.pop_back();
+        const Node& original = td.getNode(original_id);
+        bag.assign(original.bag.begin(), original.bag.end());
+        std::sort(bag.begin(), bag.end());
+
+        Node_Id n_id = parent_id;
+        if (parent_id == NO_NODE) {
+            n_id = addNode(NO_NODE, bag);
+        }
+        else {
+            // Forgets the vertices only in the parent's bag one after another, then introduces those only in the child's. The last step is the node itself, and without any step it is merged into its parent.
+            const std::span<const Vertex_Id> parent_bag = flat_td.getBag(parent_id);
+            cur_bag.assign(parent_bag.begin(), parent_bag.end());
+            only_in_parent.clear();
+            only_in_child.clear();
+            std::set_difference(cur_bag.begin(), cur_bag.end(), bag.begin(), bag.end(), std::back_inserter(only_in_parent));
+            std::set_difference(bag.begin(), bag.end(), cur_bag.begin(), cur_bag.end(), std::back_inserter(only_in_child));
+
+            size_t steps_left = only_in_parent.size() + only_in_child.size();
+            for (const Vertex_Id v_id : only_in_parent) {
+                if (--steps_left == 0)
+                    break;
+                cur_bag.erase(std::lower_bound(cur_bag.begin(), cur_bag.end(), v_id));
+                n_id = addNode(n_id, cur_bag);
+            }
+            for (const Vertex_Id v_id : only_in_child) {
+                if (--steps_left == 0)
+                    break;
+                cur_bag.insert(std::lower_bound(cur_bag.begin(), cur_bag.end(), v_id), v_id);
+                n_id = addNode(n_id, cur_bag);
+            }
+            if (!only_in_parent.empty() || !only_in_child.empty())
+                n_id = addNode(n_id, bag);
+        }
+
+        if (original.children.empty()) {
+            // Leaves keep a single vertex.
+            while (bag.size() >= 2) {
+                bag.pop_back();
+                n_id = addNode(n_id, bag);
+            }
+        }
+        else if (original.children.size() == 1) {
+            tasks.push_back({*original.children.begin(), n_id});
+        }
+        else {
+            std::deque<std::pair<double, Node_Id>> leaves;
+            for (const Node_Id child_id : original.children) {
+                const Node_Id leaf_id = addNode(NO_NODE, bag);
+                tasks.push_back({child_id, leaf_id});
+                leaves.push_back({join_tree_shape == JoinTreeShape::Weighted ? subtree_costs.at(child_id) : 0.0, leaf_id});
+            }
+            buildJoinTree(std::move(leaves), join_tree_shape, [&flat_td, &addNode, &bag, n_id](Node_Id n_id1, Node_Id n_id2, bool is_last_join) {
+                const Node_Id join_id = is_last_join ? n_id : addNode(NO_NODE, bag);
+                flat_td.parents[n_id1] = join_id;
+                flat_td.parents[n_id2] = join_id;
+                return join_id;
+            });
+        }
+    }
+
+    flat_td.root = 0;
+    flat_td.linkChildren();
+    return flat_td;
+}
+
+void FlatTreeDecomposition::linkChildren() {
+    child_offsets.assign(parents.size() + 1, 0);
+    for (const Node_Id parent_id : parents) {
+        if (parent_id != NO_NODE)
+            child_offsets[parent_id + 1]++;
+    }
+    for (size_t n_id = 0; n_id < parents.size(); n_id++)
+        child_offsets[n_id + 1] += child_offsets[n_id];
+
+    children.resize(child_offsets.back());
+    std::vector<size_t> next_child{child_offsets.begin(), child_offsets.end() - 1};
+    for (size_t n_id = 0; n_id < parents.size(); n_id++) {
+        if (parents[n_id] != NO_NODE)
+            children[next_child[parents[n_id]]++] = n_id;
+    }
+
+    pre_order.clear();
+    pre_order.reserve(parents.size());
+    std::vector<Node_Id> stack{root};
+    while (!stack.empty()) {
+        const Node_Id n_id = stack.back();
+        stack.pop_back();
+        pre_order.push_back(n_id);
+        const std::span<const Node_Id> node_children = getChildren(n_id);
+        stack.insert(stack.end(), node_children.rbegin(), node_children.rend());
+    }
+}
+
+Node_Id FlatTreeDecomposition::getRoot() const {
+    return root;
+}
+
+size_t FlatTreeDecomposition::numberOfNodes() const {
+    return pre_order.size();
+}
+
+size_t FlatTreeDecomposition::idBound() const {
+    return parents.size();
+}
+
+const std::vector<Node_Id>& FlatTreeDecomposition::getPreOrder() const {
+    return pre_order;
+}
+
+std::span<const Vertex_Id> FlatTreeDecomposition::getBag(Node_Id n_id) const {
+    return std::span<const Vertex_Id>(bags).subspan(bag_offsets[n_id], bag_offsets[n_id + 1] - bag_offsets[n_id]);
+}
+
+std::span<const Node_Id> FlatTreeDecomposition::getChildren(Node_Id n_id) const {
+    return std::span<const Node_Id>(children).subspan(child_offsets[n_id], child_offsets[n_id + 1] - child_offsets[n_id]);
+}
+
+std::optional<Node_Id> FlatTreeDecomposition::getParent(Node_Id n_id) const {
+    return parents[n_id] == NO_NODE ? std::nullopt : std::optional{parents[n_id]};
+}
+
+size_t FlatTreeDecomposition::getTreewidth() const {
+    size_t max_bag_size = 0;
+    for (const Node_Id n_id : pre_order)
+        max_bag_size = std::max(max_bag_size, bag_offsets[n_id + 1] - bag_offsets[n_id]);
+    // As in `TreeDecomposition::getTreewidth`, empty bags have width 0.
+    return std::max<size_t>(max_bag_size, 1) - 1;
+}
+
+bool FlatTreeDecomposition::isNice() const {
+    for (const Node_Id n_id : pre_order) {
+        const std::span<const Vertex_Id> bag = getBag(n_id);
+        const std::span<const Node_Id> node_children = getChildren(n_id);
+        if (node_children.size() == 1) {
+            const std::span<const Vertex_Id> child_bag = getBag(node_children[0]);
+            const bool is_introduce = bag.size() == child_bag.size() + 1 && std::includes(bag.begin(), bag.end(), child_bag.begin(), child_bag.end());
+            const bool is_forget = child_bag.size() == bag.size() + 1 && std::includes(child_bag.begin(), child_bag.end(), bag.begin(), bag.end());
+            if (!is_introduce && !is_forget)
+                return false;
+        }
+        else if (node_children.size() >= 2) {
+            for (const Node_Id child_id : node_children) {
+                if (!std::ranges::equal(bag, getBag(child_id)))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
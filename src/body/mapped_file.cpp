@@ -0,0 +1,39 @@
+#include "mapped_file.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::invalid_argument("Could not open " + path + ": " + std::strerror(errno));
+
+    struct stat file_status;
+    if (fstat(fd, &file_status) == -1) {
+        close(fd);
+        throw std::invalid_argument("Could not read the size of " + path + ": " + std::strerror(errno));
+    }
+    size = file_status.st_size;
+
+    // Empty files cannot be mapped, but they do not need to be.
+    if (size > 0) {
+        void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED) {
+            close(fd);
+            throw std::invalid_argument("Could not map " + path + ": " + std::strerror(errno));
+        }
+        madvise(ptr, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(ptr);
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+}
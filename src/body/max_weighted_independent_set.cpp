@@ -0,0 +1,53 @@
+#include "max_weighted_independent_set.h"
+
+#include <algorithm>
+
+/*
+The kernels walk the tables in blocks of 2^pos consecutive entries that agree on all bits but the one at `pos`, so that the inner loops are free of index arithmetic and left to the compiler to vectorize.
+*/
+void IndependentSetProblem::introduce(const Value* child, Value* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Weight v_weight) {
+    const size_t block = size_t{1} << pos;
+    for (size_t high = 0; high < child_size; high += block) {
+        for (size_t low = 0; low < block; low++) {
+            const Cover_Mask U_prime = high + low;
+            const Value weight = child[U_prime];
+            out[2 * high + low] = weight;
+            // v can only join if none of its neighbours in the bag is part of the set.
+            out[2 * high + block + low] = weight == INVALID_SET || (U_prime & neighbour_mask) != 0 ? INVALID_SET : weight + v_weight;
+        }
+    }
+}
+
+void IndependentSetProblem::forget(const Value* child, Value* out, uint64_t* choices, size_t out_size, size_t pos) {
+    const size_t block = size_t{1} << pos;
+    for (size_t high = 0; high < out_size; high += block) {
+        for (size_t low = 0; low < block; low++) {
+            const Cover_Mask U = high + low;
+            const Value weight_without_v = child[2 * high + low];
+            const Value weight_with_v = child[2 * high + block + low];
+            if (weight_with_v > weight_without_v) {
+                out[U] = weight_with_v;
+                choices[U >> 6] |= uint64_t{1} << (U & 63);
+            }
+            else {
+                out[U] = weight_without_v;
+            }
+        }
+    }
+}
+
+void IndependentSetProblem::join(const Value* left, const Value* right, Value* out, size_t size, const std::vector<Vertex_Weight>& bag_weights) {
+    forEachSubsetWeightBlock(bag_weights, size, [&](size_t start, size_t block_size, const Vertex_Weight* low_weights, Vertex_Weight high_weight) {
+        for (size_t U = start; U < start + block_size; U++)
+            out[U] = left[U] == INVALID_SET || right[U] == INVALID_SET ? INVALID_SET : left[U] + right[U] - (low_weights[U - start] + high_weight);
+    });
+}
+
+IndependentSetProblem::Value IndependentSetProblem::aggregate(const Value* root, size_t size, size_t& best) {
+    best = std::max_element(root, root + size) - root;
+    return root[best];
+}
+
+std::ostream &operator<<(std::ostream &os, const IndependentSetSolution &sol) {
+    return os << "(" << sol.independent_set << "," << sol.total_weight << ")";
+}
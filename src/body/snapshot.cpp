@@ -0,0 +1,205 @@
+#include "snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char MAGIC[8] = {'D', 'P', 'T', 'D', 'S', 'N', 'A', 'P'};
+
+constexpr size_t ALIGNMENT = 8;
+
+// Writes `values` and pads them to a multiple of ALIGNMENT bytes.
+template<typename T>
+void writeSection(std::ostream& out, const std::vector<T>& values) {
+    const size_t bytes = values.size() * sizeof(T);
+    out.write(reinterpret_cast<const char*>(values.data()), bytes);
+    const char padding[ALIGNMENT] = {};
+    out.write(padding, (ALIGNMENT - bytes % ALIGNMENT) % ALIGNMENT);
+}
+
+// Returns the `count` values of type T at `offset` and moves `offset` behind their padding.
+template<typename T>
+std::span<const T> readSection(std::string_view contents, size_t& offset, uint64_t count) {
+    if (count > (contents.size() - offset) / sizeof(T))
+        throw std::invalid_argument("Truncated snapshot.");
+    const T* data = reinterpret_cast<const T*>(contents.data() + offset);
+    const size_t bytes = count * sizeof(T);
+    offset = std::min(contents.size(), offset + bytes + (ALIGNMENT - bytes % ALIGNMENT) % ALIGNMENT);
+    return {data, count};
+}
+
+// Offsets have to start at 0, never decrease and end at the number of entries they index.
+void checkOffsets(std::span<const uint64_t> offsets, uint64_t number_of_entries) {
+    if (offsets.front() != 0 || offsets.back() != number_of_entries || !std::is_sorted(offsets.begin(), offsets.end()))
+        throw std::invalid_argument("Corrupt snapshot: Invalid offsets.");
+}
+
+void checkIds(std::span<const uint64_t> ids, uint64_t bound) {
+    if (std::any_of(ids.begin(), ids.end(), [bound](uint64_t id) { return id >= bound; }))
+        throw std::invalid_argument("Corrupt snapshot: Id out of range.");
+}
+
+}
+
+/*
+The nodes are renumbered in the pre-order of `td`, so that loading checks the tree by comparing every parent with its child.
+*/
+void Snapshot::save(const std::string& path, const UndirectedGraph& graph, const FlatTreeDecomposition& td) {
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+
+    const size_t number_of_ids = graph.vertex_id_to_name.size();
+    std::vector<uint64_t> vertices(graph.vertices.begin(), graph.vertices.end());
+    std::vector<int32_t> weights(graph.vertex_id_to_weight.begin(), graph.vertex_id_to_weight.end());
+    std::vector<uint64_t> adjacency_offsets(graph.neighbour_offsets.begin(), graph.neighbour_offsets.end());
+    std::vector<uint64_t> adjacencies(graph.neighbours.begin(), graph.neighbours.end());
+    std::vector<uint64_t> name_offsets = {0};
+    std::vector<char> names;
+    for (Vertex_Id v_id = 0; v_id < number_of_ids; v_id++) {
+        names.insert(names.end(), graph.vertex_id_to_name[v_id].begin(), graph.vertex_id_to_name[v_id].end());
+        name_offsets.push_back(names.size());
+    }
+    std::vector<uint64_t> edges;
+    for (const auto& [v_id, u_id] : graph.edges) {
+        edges.push_back(v_id);
+        edges.push_back(u_id);
+    }
+
+    std::vector<uint64_t> number(td.idBound(), NO_NODE);
+    std::vector<uint64_t> parents;
+    std::vector<uint64_t> bag_offsets = {0};
+    std::vector<uint64_t> bags;
+    for (const Node_Id n_id : td.getPreOrder()) {
+        number[n_id] = parents.size();
+        const std::optional<Node_Id> parent = td.getParent(n_id);
+        parents.push_back(parent.has_value() ? number[parent.value()] : NO_NODE);
+        const std::span<const Vertex_Id> bag = td.getBag(n_id);
+        bags.insert(bags.end(), bag.begin(), bag.end());
+        bag_offsets.push_back(bags.size());
+    }
+
+    header.flags = td.isNice() ? NICE : uint32_t{0};
+    header.number_of_ids = number_of_ids;
+    header.number_of_vertices = vertices.size();
+    header.number_of_adjacencies = adjacencies.size();
+    header.number_of_edges = graph.edges.size();
+    header.names_bytes = names.size();
+    header.number_of_nodes = parents.size();
+    header.number_of_bag_entries = bags.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeSection(out, vertices);
+    writeSection(out, weights);
+    writeSection(out, adjacency_offsets);
+    writeSection(out, adjacencies);
+    writeSection(out, name_offsets);
+    writeSection(out, names);
+    writeSection(out, edges);
+    writeSection(out, parents);
+    writeSection(out, bag_offsets);
+    writeSection(out, bags);
+    out.close();
+    if (!out)
+        throw std::runtime_error("Could not write snapshot " + path + ".");
+}
+
+Snapshot::Snapshot(const std::string& path) : file(path) {
+    static_assert(sizeof(Header) % ALIGNMENT == 0);
+
+    const std::string_view contents = file.contents();
+    if (contents.size() < sizeof(Header) || std::memcmp(contents.data(), MAGIC, sizeof(MAGIC)) != 0)
+        throw std::invalid_argument(path + " is not a snapshot.");
+    std::memcpy(&header, contents.data(), sizeof(Header));
+    if (header.version != VERSION)
+        throw std::invalid_argument(path + " is a snapshot of version " + std::to_string(header.version) + ", but only version " + std::to_string(VERSION) + " is supported.");
+
+    size_t offset = sizeof(Header);
+    vertices = readSection<uint64_t>(contents, offset, header.number_of_vertices);
+    weights = readSection<int32_t>(contents, offset, header.number_of_ids);
+    adjacency_offsets = readSection<uint64_t>(contents, offset, header.number_of_ids + 1);
+    adjacencies = readSection<uint64_t>(contents, offset, header.number_of_adjacencies);
+    name_offsets = readSection<uint64_t>(contents, offset, header.number_of_ids + 1);
+    names = readSection<char>(contents, offset, header.names_bytes);
+    edges = readSection<uint64_t>(contents, offset, 2 * header.number_of_edges);
+    parents = readSection<uint64_t>(contents, offset, header.number_of_nodes);
+    bag_offsets = readSection<uint64_t>(contents, offset, header.number_of_nodes + 1);
+    bags = readSection<uint64_t>(contents, offset, header.number_of_bag_entries);
+    if (offset != contents.size())
+        throw std::invalid_argument("Corrupt snapshot: Unexpected size.");
+
+    checkOffsets(adjacency_offsets, adjacencies.size());
+    checkOffsets(name_offsets, names.size());
+    checkOffsets(bag_offsets, bags.size());
+    checkIds(vertices, header.number_of_ids);
+    checkIds(adjacencies, header.number_of_ids);
+    checkIds(edges, header.number_of_ids);
+    checkIds(bags, header.number_of_ids);
+    // Node 0 is the root and every other node comes after its parent, so that the parents form a single tree.
+    if (parents.empty() || parents[0] != NO_NODE)
+        throw std::invalid_argument("Corrupt snapshot: Node 0 is not the root.");
+    for (size_t i = 1; i < parents.size(); i++) {
+        if (parents[i] >= i)
+            throw std::invalid_argument("Corrupt snapshot: Node " + std::to_string(i) + " does not come after its parent.");
+    }
+    for (size_t i = 0; i < parents.size(); i++) {
+        if (!std::is_sorted(bags.begin() + bag_offsets[i], bags.begin() + bag_offsets[i + 1]))
+            throw std::invalid_argument("Corrupt snapshot: Unsorted bag.");
+    }
+}
+
+/*
+The vertices keep their ids. Only names that are not small numbers are hashed, as when parsing.
+*/
+UndirectedGraph Snapshot::graph() const {
+    UndirectedGraph graph;
+    graph.vertices.assign(vertices.begin(), vertices.end());
+    graph.vertex_id_to_weight.assign(weights.begin(), weights.end());
+    graph.vertex_id_to_name.reserve(header.number_of_ids);
+    for (size_t v_id = 0; v_id < header.number_of_ids; v_id++) {
+        graph.vertex_id_to_name.emplace_back(names.data() + name_offsets[v_id], name_offsets[v_id + 1] - name_offsets[v_id]);
+        graph.indexName(v_id);
+    }
+    graph.next_free_id = header.number_of_ids;
+
+    graph.neighbour_offsets.assign(adjacency_offsets.begin(), adjacency_offsets.end());
+    graph.neighbours.assign(adjacencies.begin(), adjacencies.end());
+    graph.indexNeighbours();
+
+    graph.edges.resize(header.number_of_edges);
+    for (size_t i = 0; i < header.number_of_edges; i++)
+        graph.edges[i] = {edges[2 * i], edges[2 * i + 1]};
+
+    return graph;
+}
+
+FlatTreeDecomposition Snapshot::flatTreeDecomposition() const {
+    FlatTreeDecomposition td;
+    td.root = 0;
+    td.parents.assign(parents.begin(), parents.end());
+    td.bag_offsets.assign(bag_offsets.begin(), bag_offsets.end());
+    td.bags.assign(bags.begin(), bags.end());
+    td.linkChildren();
+    return td;
+}
+
+// The edges are added before rooting, so that they do not set parents on their own.
+TreeDecomposition Snapshot::treeDecomposition(const UndirectedGraph& graph) const {
+    TreeDecomposition td(graph);
+    for (size_t i = 0; i < header.number_of_nodes; i++) {
+        const Node_Id n_id = td.addNode(std::to_string(i));
+        td.nodes.at(n_id).bag.insert(bags.begin() + bag_offsets[i], bags.begin() + bag_offsets[i + 1]);
+        if (i > 0)
+            td.addEdge(parents[i], n_id);
+    }
+    td.rootTree(0);
+    return td;
+}
+
+bool Snapshot::isNice() const {
+    return header.flags & NICE;
+}
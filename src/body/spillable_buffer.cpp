@@ -0,0 +1,63 @@
+#include "spillable_buffer.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+std::string SpillOptions::defaultSpillDirectory() {
+    const char* tmpdir = std::getenv("TMPDIR");
+    return tmpdir != nullptr && *tmpdir != '\0' ? tmpdir : "/tmp";
+}
+
+void* mapTemporaryFile(size_t bytes, const std::string& directory) {
+    std::string path_template = directory + "/dp-table-XXXXXX";
+    std::vector<char> path{path_template.begin(), path_template.end()};
+    path.push_back('\0');
+
+    int fd = mkstemp(path.data());
+    if (fd == -1)
+        throw std::runtime_error("Could not create a temporary file in " + directory + ": " + std::strerror(errno));
+
+    // The file is only reachable through the mapping and disappears with it.
+    unlink(path.data());
+
+    if (ftruncate(fd, bytes) == -1) {
+        close(fd);
+        throw std::runtime_error("Could not resize temporary file to " + std::to_string(bytes) + " bytes: " + std::strerror(errno));
+    }
+
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        throw std::runtime_error("Could not map temporary file: " + std::string(std::strerror(errno)));
+
+    // All DP kernels stream through their tables, so aggressive readahead pays off.
+    madvise(ptr, bytes, MADV_SEQUENTIAL);
+
+    return ptr;
+}
+
+void unmapTemporaryFile(void* ptr, size_t bytes) {
+    munmap(ptr, bytes);
+}
+
+void* mapHugePages(size_t bytes) {
+    void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        throw std::runtime_error("Could not map " + std::to_string(bytes) + " bytes: " + std::strerror(errno));
+
+#ifdef MADV_HUGEPAGE
+    // Only a hint: Without transparent huge page support this is ordinary anonymous memory.
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+
+    return ptr;
+}
+
+void unmapHugePages(void* ptr, size_t bytes) {
+    munmap(ptr, bytes);
+}
@@ -0,0 +1,64 @@
+#include "table_arena.h"
+
+#include <algorithm>
+#include <iterator>
+
+/*
+Only a buffer with the backing `options` asks for is handed out, even if the options changed since it was recycled. Buffers of another backing stay in the pool.
+*/
+template<typename T>
+SpillableBuffer<T> TableArena<T>::acquire(size_t size, const SpillOptions& options) {
+    const typename SpillableBuffer<T>::Backing backing = SpillableBuffer<T>::backingFor(size, options);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        acquired_buffers++;
+        const auto it = free_buffers.find(size);
+        if (it != free_buffers.end()) {
+            std::vector<SpillableBuffer<T>>& buffers = it->second;
+            const auto match = std::find_if(buffers.rbegin(), buffers.rend(), [backing](const SpillableBuffer<T>& buffer) { return buffer.getBacking() == backing; });
+            if (match != buffers.rend()) {
+                SpillableBuffer<T> buffer = std::move(*match);
+                buffers.erase(std::next(match).base());
+                reused_buffers++;
+                return buffer;
+            }
+        }
+    }
+
+    SpillableBuffer<T> buffer;
+    buffer.allocate(size, options);
+    return buffer;
+}
+
+template<typename T>
+void TableArena<T>::recycle(SpillableBuffer<T>&& buffer) {
+    if (buffer.size() == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<SpillableBuffer<T>>& buffers = free_buffers[buffer.size()];
+    if (buffers.size() < max_free_per_size)
+        buffers.push_back(std::move(buffer));
+}
+
+template<typename T>
+void TableArena<T>::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    free_buffers.clear();
+}
+
+template<typename T>
+size_t TableArena<T>::numberOfAcquiredBuffers() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return acquired_buffers;
+}
+
+template<typename T>
+size_t TableArena<T>::numberOfReusedBuffers() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reused_buffers;
+}
+
+// The value types of the DP problems (vertex weights and counts).
+template class TableArena<Vertex_Cover_Weight>;
+template class TableArena<uint64_t>;
@@ -0,0 +1,113 @@
+#include "thread_pool.h"
+
+#include <utility>
+
+// Identifies the pool and worker the current thread belongs to (if any).
+static thread_local const WorkStealingThreadPool* current_pool = nullptr;
+static thread_local size_t current_worker_index = 0;
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t num_threads) {
+    if (num_threads == 0)
+        num_threads = 1;
+
+    for (size_t i = 0; i < num_threads; i++)
+        queues.push_back(std::make_unique<WorkerQueue>());
+    for (size_t i = 0; i < num_threads; i++)
+        workers.emplace_back(&WorkStealingThreadPool::workerLoop, this, i);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void WorkStealingThreadPool::submit(Task task) {
+    size_t queue_index = current_pool == this ? current_worker_index : next_queue++ % queues.size();
+
+    unfinished_tasks++;
+    {
+        std::lock_guard<std::mutex> lock(queues[queue_index]->mutex);
+        queues[queue_index]->tasks.push_back(std::move(task));
+    }
+    queued_tasks++;
+
+    // Taking the lock ensures that no worker misses the update between checking for work and going to sleep.
+    { std::lock_guard<std::mutex> lock(idle_mutex); }
+    work_available.notify_one();
+}
+
+void WorkStealingThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(idle_mutex);
+    all_done.wait(lock, [this]() { return unfinished_tasks == 0; });
+    if (exception) {
+        failed = false;
+        std::rethrow_exception(std::exchange(exception, nullptr));
+    }
+}
+
+size_t WorkStealingThreadPool::numberOfThreads() const {
+    return workers.size();
+}
+
+void WorkStealingThreadPool::workerLoop(size_t worker_index) {
+    current_pool = this;
+    current_worker_index = worker_index;
+
+    while (true) {
+        Task task;
+        if (popLocal(worker_index, task) || steal(worker_index, task)) {
+            queued_tasks--;
+            if (!failed) {
+                try {
+                    task();
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(idle_mutex);
+                    if (!exception)
+                        exception = std::current_exception();
+                    failed = true;
+                }
+            }
+            if (--unfinished_tasks == 0) {
+                { std::lock_guard<std::mutex> lock(idle_mutex); }
+                all_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        work_available.wait(lock, [this]() { return stopping || queued_tasks > 0; });
+        if (stopping)
+            return;
+    }
+}
+
+bool WorkStealingThreadPool::popLocal(size_t worker_index, Task& task) {
+    WorkerQueue& queue = *queues[worker_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingThreadPool::steal(size_t worker_index, Task& task) {
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        WorkerQueue& queue = *queues[(worker_index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,47 @@
+#include "three_coloring.h"
+
+#include <numeric>
+
+/*
+As for the binary problems, the kernels walk the tables in blocks of 3^pos consecutive entries that agree on all digits but the one at `pos`.
+*/
+void ThreeColoringProblem::introduce(const Value* child, Value* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Weight) {
+    // Place values of the digits of v's neighbours in the child's bag.
+    std::vector<size_t> neighbour_place_values;
+    size_t place_value = 1;
+    for (Cover_Mask mask = neighbour_mask; mask != 0; mask >>= 1, place_value *= 3) {
+        if (mask & 1)
+            neighbour_place_values.push_back(place_value);
+    }
+
+    const size_t block = tableSize<STATES>(pos);
+    for (size_t high = 0; high < child_size; high += block) {
+        for (size_t low = 0; low < block; low++) {
+            const size_t index = high + low;
+            unsigned used_colors = 0;
+            for (const size_t neighbour_place_value : neighbour_place_values)
+                used_colors |= 1u << (index / neighbour_place_value % 3);
+
+            for (size_t color = 0; color < 3; color++)
+                out[3 * high + color * block + low] = used_colors >> color & 1 ? 0 : child[index];
+        }
+    }
+}
+
+void ThreeColoringProblem::forget(const Value* child, Value* out, uint64_t*, size_t out_size, size_t pos) {
+    const size_t block = tableSize<STATES>(pos);
+    for (size_t high = 0; high < out_size; high += block) {
+        for (size_t low = 0; low < block; low++)
+            out[high + low] = child[3 * high + low] + child[3 * high + block + low] + child[3 * high + 2 * block + low];
+    }
+}
+
+void ThreeColoringProblem::join(const Value* left, const Value* right, Value* out, size_t size, const std::vector<Vertex_Weight>&) {
+    for (size_t index = 0; index < size; index++)
+        out[index] = left[index] * right[index];
+}
+
+ThreeColoringProblem::Value ThreeColoringProblem::aggregate(const Value* root, size_t size, size_t& best) {
+    best = 0;
+    return std::accumulate(root, root + size, Value{0});
+}
@@ -1,8 +1,13 @@
 #include "tree_decomposition.h"
 #include "undirected_graph.h"
 #include "util.h"
+#include "mapped_file.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <numeric>
+#include <stdexcept>
 #include <stack>
 
 using std::string;
@@ -14,44 +19,128 @@ Cases:
 I. N1,N2        ... Edge between nodes
 II. N1,,a;b;c   ... Set bag for node
 */
+// The file is memory-mapped and scanned in place.
 TreeDecomposition TreeDecomposition::parseUnsafe(const std::string &input_path, const UndirectedGraph& graph)
 {
-    std::ifstream input(input_path);
-    if (!input) {
-        throw std::invalid_argument::exception();
-    }
+    const MappedFile input{input_path};
 
     TreeDecomposition td{graph};
 
-    string line;
-    while (getline(input, line)) {
-        if (line == "")
-            continue;
+    const bool is_pace = endsWith(input_path, ".td") || (!endsWith(input_path, ".csv") && firstContentLine(input.contents(), 'c').starts_with("s "));
+    if (is_pace)
+        td.parsePace(input.contents());
+    else
+        td.parseCsv(input.contents());
 
-        std::vector<string> comma_parts = stringSplit(line, ',');
-        std::string& n1_name = comma_parts[0];
-        std::string& n2_name = comma_parts[1];
-        
-        if (comma_parts.size() == 2) { // Case I
-            Node_Id n1_id = td.addNode(n1_name);
-            Node_Id n2_id = td.addNode(n2_name);
-            td.addEdge(n1_id, n2_id);
-        }
-        else if (comma_parts.size() == 3) { // Case II
-            std::vector<string> bag_contents_names = stringSplit(comma_parts[2], ';');
-            Node_Id n_id = td.addNode(n1_name);
+    return td;
+}
+
+/*
+I.  N1,N2        ... Edge between the nodes N1 and N2
+II. N1,,a;b;c    ... Bag of N1
+*/
+void TreeDecomposition::parseCsv(std::string_view contents) {
+    std::vector<std::optional<Node_Id>> numeric_name_to_id;
+
+    forEachLine(contents, [this, &numeric_name_to_id](std::string_view line) {
+        std::string_view comma_parts[3];
+        size_t number_of_parts = 0;
+        forEachToken(line, ',', [&comma_parts, &number_of_parts](std::string_view part) {
+            if (number_of_parts < 3)
+                comma_parts[number_of_parts] = part;
+            number_of_parts++;
+        });
+
+        if (number_of_parts == 2) { // Case I
+            Node_Id n1_id = addNode(comma_parts[0], numeric_name_to_id);
+            Node_Id n2_id = addNode(comma_parts[1], numeric_name_to_id);
+            addEdge(n1_id, n2_id);
+        }
+        else if (number_of_parts == 3) { // Case II
+            Node_Id n_id = addNode(comma_parts[0], numeric_name_to_id);
             Bag bag;
-            for (const string& v_name : bag_contents_names) {
-                bag.insert(graph.nameToId(v_name));
-            }
-            td.nodes[n_id].bag = bag;
+            forEachToken(comma_parts[2], ';', [this, &bag](std::string_view v_name) {
+                bag.insert(graph_ptr->nameToId(v_name));
+            });
+            nodes[n_id].bag = std::move(bag);
         }
         else {
-            throw std::invalid_argument::exception();
+            throw std::invalid_argument("Invalid line " + string(line) + ".");
         }
-    }
+    });
+}
 
-    return td;
+/*
+PACE 2017 tree decomposition format:
+    c ...            ... Comment
+    s td b w n       ... Header: b bags, named 1, ..., b, of at most w (the width + 1) vertices each
+    b i v1 v2 ...    ... Bag of node i
+    i j              ... Edge between the nodes i and j
+*/
+void TreeDecomposition::parsePace(std::string_view contents) {
+    std::vector<std::optional<Node_Id>> numeric_name_to_id;
+    std::optional<size_t> number_of_bags;
+    size_t max_bag_size = 0;
+
+    forEachLine(contents, [this, &numeric_name_to_id, &number_of_bags, &max_bag_size](std::string_view line) {
+        if (line[0] == 'c')
+            return;
+
+        std::string_view parts[5];
+        size_t number_of_parts = 0;
+        forEachToken(line, ' ', [&parts, &number_of_parts](std::string_view part) {
+            if (part.empty())
+                return;
+            if (number_of_parts < 5)
+                parts[number_of_parts] = part;
+            number_of_parts++;
+        });
+
+        // The nodes 1, ..., b are all created by the header.
+        auto node = [&numeric_name_to_id, &number_of_bags, line](std::string_view part) {
+            const std::optional<size_t> i = parseNumber<size_t>(part);
+            if (!i.has_value() || i == 0 || i > number_of_bags)
+                throw std::invalid_argument("Invalid node " + string(part) + " in line " + string(line) + ".");
+            return numeric_name_to_id[i.value()].value();
+        };
+
+        if (parts[0] == "s") {
+            const std::optional<size_t> bags = parseNumber<size_t>(parts[2]);
+            const std::optional<size_t> width = parseNumber<size_t>(parts[3]);
+            if (number_of_parts != 5 || parts[1] != "td" || !bags.has_value() || !width.has_value() || number_of_bags.has_value())
+                throw std::invalid_argument("Invalid header " + string(line) + ".");
+            number_of_bags = bags;
+            max_bag_size = width.value();
+            for (size_t i = 1; i <= bags.value(); i++)
+                addNode(std::to_string(i), numeric_name_to_id);
+        }
+        else if (parts[0] == "b" && number_of_bags.has_value()) {
+            if (number_of_parts < 2)
+                throw std::invalid_argument("Invalid line " + string(line) + ".");
+            const Node_Id n_id = node(parts[1]);
+            Bag bag;
+            size_t index = 0;
+            forEachToken(line, ' ', [this, &bag, &index](std::string_view part) {
+                if (part.empty())
+                    return;
+                if (index > 1)
+                    bag.insert(graph_ptr->nameToId(part));
+                index++;
+            });
+            if (bag.size() > max_bag_size)
+                throw std::invalid_argument("Bag larger than the width in the header in line " + string(line) + ".");
+            nodes[n_id].bag = std::move(bag);
+        }
+        else if (number_of_parts == 2 && number_of_bags.has_value()) {
+            addEdge(node(parts[0]), node(parts[1]));
+        }
+        else {
+            throw std::invalid_argument("Invalid line " + string(line) + ".");
+        }
+    });
+
+    if (!number_of_bags.has_value())
+        throw std::invalid_argument("Missing \"s td\" header.");
 }
 
 /*
@@ -65,43 +154,54 @@ How to get a nice tree decomposition:
 1. Between any two (connected) nodes, "subdivide" the difference in their bags into several nodes such that each new node is either a forget node or an introduce node (method `bridgeDifference`).
 2. Let C be the set of children of a node n with bag B. If |C| >= 2:
     a. Detach the children of n.
-    b. Create a chain of introduce nodes - each with bag B - such that you can then attach the prior children of n to the left end of the new introduce nodes (method `makeNJoinNodeNice`).
+    b. Create a binary tree of join nodes - each with bag B - such that you can then attach the prior children of n to its leaves (method `makeNJoinNodeNice`).
 */
-bool TreeDecomposition::isNiceTreeDecomposition() const
-{
-    bool is_valid = true;
-    doWhilePreOrder([this, &is_valid](const Node_Id& n_id) {
-        const auto& node = nodes.at(n_id);
-        if (node.children.size() == 0) {
-            return;
-        }
-        else if (node.children.size() == 1) {
-            Node_Id child_id = *node.children.begin();
-            const auto& child = nodes.at(child_id);
-            size_t diff1 = setDifferrence(node.bag, child.bag).size();
-            size_t diff2 = setDifferrence(child.bag, node.bag).size();
-            if (!(diff1 == 0 && diff2 == 1 || diff1 == 1 && diff2 == 0)) {
-                is_valid = false;
-            }
-            return;
-        }
-        else {
-            for (const Node_Id& child_id : node.children) {
-                const auto& child = nodes.at(child_id);
-                if (child.bag != node.bag) {
-                    is_valid = false;
-                    return;
-                }
-            }
-        }
+bool TreeDecomposition::isNiceTreeDecomposition() const {
+    if (!isRooted())
+        return false;
+
+    bool is_nice = true;
+    doSomethingPreOrder([this, &is_nice](Node_Id n_id) {
+        is_nice = is_nice && nodeType(n_id) != NiceNodeType::Other;
+    });
+    return is_nice;
+}
 
-    }, [&is_valid](){return is_valid;});
+NiceNodeType TreeDecomposition::nodeType(Node_Id n_id) const {
+    const Node& node = nodes.at(n_id);
+    if (node.children.empty())
+        return NiceNodeType::Leaf;
+
+    if (node.children.size() == 1) {
+        const Bag& child_bag = nodes.at(*node.children.begin()).bag;
+        if (node.bag.size() == child_bag.size() + 1 && setDifferrence(child_bag, node.bag).empty())
+            return NiceNodeType::Introduce;
+        if (child_bag.size() == node.bag.size() + 1 && setDifferrence(node.bag, child_bag).empty())
+            return NiceNodeType::Forget;
+        return NiceNodeType::Other;
+    }
 
-    return is_valid;
+    for (const Node_Id& child_id : node.children) {
+        if (nodes.at(child_id).bag != node.bag)
+            return NiceNodeType::Other;
+    }
+    return NiceNodeType::Join;
 }
 
-void TreeDecomposition::turnIntoNiceTreeDecomposition() {
-    doSomethingPostOrder([this](Node_Id n_id){
+void TreeDecomposition::turnIntoNiceTreeDecomposition(JoinTreeShape join_tree_shape) {
+    // The subtrees below the children of a node are made nice before the node, but their costs are estimated from the original tree.
+    std::unordered_map<Node_Id, double> subtree_costs;
+    if (join_tree_shape == JoinTreeShape::Weighted) {
+        doSomethingPostOrder([this, &subtree_costs](Node_Id n_id) {
+            const Node& node = nodes.at(n_id);
+            double cost = std::ldexp(1.0, node.bag.size());
+            for (const Node_Id child_id : node.children)
+                cost += subtree_costs.at(child_id);
+            subtree_costs[n_id] = cost;
+        });
+    }
+
+    doSomethingPostOrder([this, join_tree_shape, &subtree_costs](Node_Id n_id){
         const auto& node = nodes.at(n_id);
 
         if (node.children.size() == 0) {
@@ -119,17 +219,19 @@ void TreeDecomposition::turnIntoNiceTreeDecomposition() {
             bridgeDifference(n_id);
         }
         else if (node.children.size() >= 2) {
-            makeNJoinNodeNice(n_id);
+            makeNJoinNodeNice(n_id, join_tree_shape, subtree_costs);
         }
         });
     removeDuplicateNeighbours();
+    schedule();
 }
 
 size_t TreeDecomposition::getTreewidth() const {
     auto& max_elem = *std::max_element(nodes.begin(), nodes.end(), [this](auto n1_pair, auto n2_pair){
         return n1_pair.second.bag.size() < n2_pair.second.bag.size();
     });
-    return max_elem.second.bag.size() - 1;
+    // A tree decomposition whose bags are all empty (e.g. of a fully reduced graph) is reported to have width 0.
+    return std::max<size_t>(max_elem.second.bag.size(), 1) - 1;
 }
 
 void TreeDecomposition::bridgeDifference(const Node_Id parent_id) {
@@ -179,43 +281,38 @@ void TreeDecomposition::bridgeDifference(const Node_Id parent_id) {
     addEdge(cur_n_id, child_id);
 }
 
-void TreeDecomposition::makeNJoinNodeNice(Node_Id cur_n_id) {
-    const auto& cur_node = nodes[cur_n_id];
-
-    const std::vector<Node_Id> node_children{cur_node.children.begin(), cur_node.children.end()};
-
-    std::vector<Node_Id> full_bag_nodes;
-    Node_Id prev_new_node = cur_n_id;
+// Hangs every child below a new leaf with the bag of cur_n and joins these leaves up to cur_n (see `buildJoinTree`).
+void TreeDecomposition::makeNJoinNodeNice(Node_Id cur_n_id, JoinTreeShape join_tree_shape, const std::unordered_map<Node_Id, double>& subtree_costs) {
+    const Bag bag = nodes.at(cur_n_id).bag;
+    const std::vector<Node_Id> node_children{nodes.at(cur_n_id).children.begin(), nodes.at(cur_n_id).children.end()};
 
     // Disconnect cur_n from its children
     for (Node_Id child_id : node_children) {
         removeEdge(cur_n_id, child_id);
     }
 
-    // Create 2(!) new full bag nodes n-1 times where n is the number of children
-    // and append those nodes as children to the last_node
-    for (size_t i = 0; i < node_children.size() - 1; i++) {
-        Node_Id new_node_left = addNode();
-        Node_Id new_node_right = addNode();
-        nodes[new_node_left].bag = cur_node.bag;
-        nodes[new_node_right].bag = cur_node.bag;
-        addEdge(prev_new_node, new_node_left);
-        addEdge(prev_new_node, new_node_right);
+    std::deque<std::pair<double, Node_Id>> leaves;
+    for (const Node_Id child_id : node_children) {
+        double cost = 0.0;
+        if (join_tree_shape == JoinTreeShape::Weighted) {
+            const auto it = subtree_costs.find(child_id);
+            cost = it != subtree_costs.end() ? it->second : std::ldexp(1.0, nodes.at(child_id).bag.size());
+        }
 
-        full_bag_nodes.push_back(new_node_left);
-        prev_new_node = new_node_right;
+        const Node_Id leaf_id = addNode();
+        nodes[leaf_id].bag = bag;
+        addEdge(leaf_id, child_id);
+        bridgeDifference(leaf_id);
+        leaves.push_back({cost, leaf_id});
     }
-    full_bag_nodes.push_back(prev_new_node);
-    auto count = std::count_if(full_bag_nodes.begin(), full_bag_nodes.end(), [prev_new_node](Node_Id n_id) {return n_id == prev_new_node;});
-
-    // Append the children to every full-bag node and bridge the difference to it
-    for (size_t i = 0; i < node_children.size(); i++) {
-        Node_Id full_bag_node = full_bag_nodes[i];
-        Node_Id child_id = node_children[i];
 
-        addEdge(full_bag_node, child_id);
-        bridgeDifference(full_bag_node);
-    }
+    buildJoinTree(std::move(leaves), join_tree_shape, [this, cur_n_id, &bag](Node_Id n_id1, Node_Id n_id2, bool is_last_join) {
+        const Node_Id join_id = is_last_join ? cur_n_id : addNode();
+        nodes[join_id].bag = bag;
+        addEdge(join_id, n_id1);
+        addEdge(join_id, n_id2);
+        return join_id;
+    });
 }
 
 std::vector<string> TreeDecomposition::getAllNodeNames() const {
@@ -228,70 +325,83 @@ std::vector<string> TreeDecomposition::getAllNodeNames() const {
     return node_names;
 }
 
+/*
+Runs in time linear in the size of the graph and the total size of all bags (with hashed bag lookups):
+    The nodes have to form a forest: Every edge of the tree decomposition joins two of its components.
+    Property 1: Every vertex occurs in some bag.
+    Property 3: In a forest, the nodes containing v are connected iff their number exceeds the number of tree edges between two of them by exactly one.
+    Property 2: Given 3, the nodes containing v form a subtree whose node closest to the root of its component is top(v). Two subtrees intersect iff one contains the top of the other, thus the edge uv is covered iff bag(top(u)) contains v or bag(top(v)) contains u.
+*/
 bool TreeDecomposition::isValid() const {
-    // Property 1: Every vertex appears in some bag
-    const std::vector<Vertex_Id> vertices = graph_ptr->getVertices();
-
-    for (auto& v_id : vertices) {
-        bool found = false;
-        for (const auto& n_pair : nodes) {
-            if (n_pair.second.bag.find(v_id) != n_pair.second.bag.end()) {
-                found = true;
-                break;
-            }
-        }
-        if (!found)
+    std::vector<Node_Id> component(next_free_id);
+    std::iota(component.begin(), component.end(), 0);
+    auto find = [&component](Node_Id n_id) {
+        while (component[n_id] != n_id)
+            n_id = component[n_id] = component[component[n_id]];
+        return n_id;
+    };
+    for (const auto& [n_id1, n_id2] : edges) {
+        const Node_Id root1 = find(n_id1);
+        const Node_Id root2 = find(n_id2);
+        if (root1 == root2)
             return false;
+        component[root1] = root2;
     }
 
-    // Property 2: Every edge appears in some bag
-    const std::vector<Edge>& edges = graph_ptr->getEdges();
-    bool success = std::all_of(edges.begin(), edges.end(), [this](const Edge& edge){
-        for (const std::pair<Node_Id, Node>& node_pair : nodes) {
-            if (contains(node_pair.second.bag, edge.first) && contains(node_pair.second.bag, edge.second))
-                return true;
+    const size_t number_of_ids = graph_ptr->getVertices().empty() ? 0 : *std::max_element(graph_ptr->getVertices().begin(), graph_ptr->getVertices().end()) + 1;
+    std::vector<size_t> occurrences(number_of_ids, 0);
+    std::vector<size_t> shared_occurrences(number_of_ids, 0);
+    for (const auto& [n_id, node] : nodes) {
+        for (const Vertex_Id v_id : node.bag) {
+            if (v_id < number_of_ids)
+                occurrences[v_id]++;
         }
-        return false;
-    });
-    if (!success) {
-        return false;
+    }
+    for (const auto& [n_id1, n_id2] : edges) {
+        const Bag& bag1 = nodes.at(n_id1).bag;
+        const Bag& bag2 = nodes.at(n_id2).bag;
+        const Bag& smaller_bag = bag1.size() <= bag2.size() ? bag1 : bag2;
+        const Bag& larger_bag = bag1.size() <= bag2.size() ? bag2 : bag1;
+        for (const Vertex_Id v_id : smaller_bag) {
+            if (v_id < number_of_ids && larger_bag.contains(v_id))
+                shared_occurrences[v_id]++;
+        }
+    }
+
+    // Properties 1 and 3
+    for (const Vertex_Id v_id : graph_ptr->getVertices()) {
+        if (occurrences[v_id] == 0 || occurrences[v_id] - shared_occurrences[v_id] != 1)
+            return false;
     }
 
-    // Property 3: For every vertex v, the subtree containing vertex v in its bags is connected.
-    success = std::all_of(vertices.begin(), vertices.end(), [this](const Vertex_Id v_id) {
-        std::unordered_set<Node_Id> visited;
-        std::stack<Node_Id> to_visit;
-        bool found = false;
-        Node_Id start;
-        for (const auto& n_pair : nodes) {
-            if (n_pair.second.bag.find(v_id) != n_pair.second.bag.end()) {
-                found = true;
-                start = n_pair.first;
-                break;
+    // Property 2: Breadth-first search from some node of every component, so that every node is visited after the nodes closer to the root.
+    std::vector<std::optional<Node_Id>> top(number_of_ids);
+    std::vector<bool> visited(next_free_id, false);
+    std::vector<Node_Id> queue;
+    for (const auto& [start_id, start_node] : nodes) {
+        if (visited[start_id])
+            continue;
+        visited[start_id] = true;
+        queue.assign({start_id});
+        for (size_t i = 0; i < queue.size(); i++) {
+            const Node& node = nodes.at(queue[i]);
+            for (const Vertex_Id v_id : node.bag) {
+                if (v_id < number_of_ids && !top[v_id].has_value())
+                    top[v_id] = queue[i];
             }
-        }
-        to_visit.push(start);
-        while (!to_visit.empty()) {
-            Node_Id cur_n_id = to_visit.top();
-            const auto& node = nodes.at(cur_n_id);
-            to_visit.pop();
-            visited.insert(cur_n_id);
-            for (const Node_Id& n_id : node.neighbours) {
-                if (!(visited.find(n_id) != visited.end()) && (nodes.at(n_id).bag.find(v_id) != nodes.at(n_id).bag.end())) {
-                    to_visit.push(n_id);
+            for (const Node_Id neighbour_id : node.neighbours) {
+                if (!visited[neighbour_id]) {
+                    visited[neighbour_id] = true;
+                    queue.push_back(neighbour_id);
                 }
             }
         }
+    }
 
-        std::unordered_set<Node_Id>compare;
-        for (const auto& node : nodes) {
-            if (node.second.bag.find(v_id) != node.second.bag.end())
-                compare.insert(node.first);
-        }
-        return visited == compare;
+    const std::vector<Edge>& graph_edges = graph_ptr->getEdges();
+    return std::all_of(graph_edges.begin(), graph_edges.end(), [this, &top](const Edge& edge) {
+        return nodes.at(top[edge.first].value()).bag.contains(edge.second) || nodes.at(top[edge.second].value()).bag.contains(edge.first);
     });
-
-    return success;
 }
 
 const std::unordered_set<TD_Edge>& TreeDecomposition::getEdges() const {
@@ -329,7 +439,13 @@ Node_Id TreeDecomposition::rootTree() {
 }
 
 void TreeDecomposition::rootTree(Node_Id designated_root) {
-    std::vector<bool> visited(nodes.size(), false);
+    // Forget a previous rooting.
+    for (auto& [n_id, node] : nodes) {
+        node.parent.reset();
+        node.children.clear();
+    }
+
+    std::vector<bool> visited(next_free_id, false);
 
     std::stack<Node_Id> to_visit;
     to_visit.push(designated_root);
@@ -352,6 +468,170 @@ void TreeDecomposition::rootTree(Node_Id designated_root) {
         }
     }
     root = designated_root;
+    invalidateSchedule();
+    schedule();
+}
+
+Node_Id TreeDecomposition::rootTree(RootSelection selection, const RootingCostModel& model) {
+    if (selection == RootSelection::LargestBag)
+        return rootTree();
+
+    const std::unordered_map<Node_Id, double> costs = estimateRootCosts(model);
+    const Node_Id best_root = std::min_element(costs.begin(), costs.end(), [](const auto& c1, const auto& c2) {
+        return c1.second < c2.second || (c1.second == c2.second && c1.first < c2.first);
+    })->first;
+    rootTree(best_root);
+    return best_root;
+}
+
+/*
+Rerooting: The cost is computed for an arbitrary first root and then carried over along every edge, as moving the root to a neighbour only changes the number of children of the two nodes and the direction of the edge between them.
+- A node with d >= 2 children becomes d - 1 join nodes and d - 1 further copies of its bag. A leaf with at least two vertices gets a chain of introduce nodes down to a single vertex.
+- The edge from a parent p to a child c becomes a chain forgetting p \ c and then introducing c \ p.
+For the peak, need(u, v) is the peak of evaluating the component of u without v rooted at u, with the children of u ordered as in a memory-aware post-order. Within the sorted children of u, leaving out a single one only shifts the terms after it, so all need(u, v) for a fixed u follow from prefix and suffix maxima.
+*/
+std::unordered_map<Node_Id, double> TreeDecomposition::estimateRootCosts(const RootingCostModel& model) const {
+    std::unordered_map<Node_Id, double> costs;
+    if (nodes.empty())
+        return costs;
+
+    auto entries = [&model](size_t bag_size) { return std::pow(double(model.states), double(bag_size)); };
+    // Entries of a chain of bags with sizes from `first` up to but excluding `end`.
+    auto chainEntries = [&entries](size_t first, size_t end) {
+        double sum = 0;
+        for (size_t k = first; k < end; k++)
+            sum += entries(k);
+        return sum;
+    };
+    auto nodeCost = [&](Node_Id n_id, size_t number_of_children) {
+        const size_t bag_size = nodes.at(n_id).bag.size();
+        if (number_of_children == 0)
+            return entries(bag_size) + (bag_size >= 2 ? chainEntries(1, bag_size) : 0);
+        const double joins = double(number_of_children - 1);
+        return entries(bag_size) * (1 + 2 * joins + model.join_weight * joins);
+    };
+    auto edgeCost = [&](Node_Id parent_id, Node_Id child_id, size_t common) {
+        const size_t parent_size = nodes.at(parent_id).bag.size();
+        const size_t child_size = nodes.at(child_id).bag.size();
+        const double forgets = chainEntries(child_size > common ? common : common + 1, parent_size);
+        const double introduces = chainEntries(common + 1, child_size);
+        return forgets + introduces;
+    };
+    auto commonSize = [this](Node_Id n1_id, Node_Id n2_id) {
+        const Bag& bag1 = nodes.at(n1_id).bag;
+        const Bag& bag2 = nodes.at(n2_id).bag;
+        const Bag& smaller = bag1.size() <= bag2.size() ? bag1 : bag2;
+        const Bag& larger = bag1.size() <= bag2.size() ? bag2 : bag1;
+        return size_t(std::count_if(smaller.begin(), smaller.end(), [&larger](Vertex_Id v_id) { return larger.contains(v_id); }));
+    };
+
+    // Pre-order from an arbitrary first root.
+    const Node_Id first_root = nodes.begin()->first;
+    std::unordered_map<Node_Id, std::optional<Node_Id>> parent_of{{first_root, std::nullopt}};
+    std::vector<Node_Id> pre_order{first_root};
+    for (size_t i = 0; i < pre_order.size(); i++) {
+        for (const Node_Id neighbour_id : nodes.at(pre_order[i]).neighbours) {
+            if (!parent_of.contains(neighbour_id)) {
+                parent_of[neighbour_id] = pre_order[i];
+                pre_order.push_back(neighbour_id);
+            }
+        }
+    }
+    std::unordered_map<Node_Id, size_t> common_with_parent;
+    for (const Node_Id n_id : pre_order) {
+        if (parent_of.at(n_id).has_value())
+            common_with_parent[n_id] = commonSize(parent_of.at(n_id).value(), n_id);
+    }
+    auto degree = [this](Node_Id n_id) { return nodes.at(n_id).neighbours.size(); };
+
+    // Table entries of the first root.
+    std::unordered_map<Node_Id, double> table_entries;
+    double first_root_entries = 0;
+    for (const Node_Id n_id : pre_order) {
+        const bool is_root = !parent_of.at(n_id).has_value();
+        first_root_entries += nodeCost(n_id, degree(n_id) - (is_root ? 0 : 1));
+        if (!is_root)
+            first_root_entries += edgeCost(parent_of.at(n_id).value(), n_id, common_with_parent.at(n_id));
+        table_entries[n_id] = entries(nodes.at(n_id).bag.size());
+    }
+
+    // need_down[v] = need(v, parent of v), need_up[v] = need(parent of v, v).
+    std::unordered_map<Node_Id, double> need_down;
+    std::unordered_map<Node_Id, double> need_up;
+    std::unordered_map<Node_Id, double> peak_as_root;
+
+    // Sorts `children` (id, need) as in a memory-aware post-order.
+    auto sortChildren = [&](std::vector<std::pair<Node_Id, double>>& children) {
+        std::sort(children.begin(), children.end(), [&table_entries](const auto& c1, const auto& c2) {
+            return c1.second - table_entries.at(c1.first) > c2.second - table_entries.at(c2.first);
+        });
+    };
+    auto need = [&](Node_Id n_id, const std::vector<std::pair<Node_Id, double>>& children) {
+        double live = 0;
+        double peak = 0;
+        for (const auto& [child_id, child_need] : children) {
+            peak = std::max(peak, live + child_need);
+            live += table_entries.at(child_id);
+        }
+        return std::max(peak, live + table_entries.at(n_id));
+    };
+
+    for (auto it = pre_order.rbegin(); it != pre_order.rend(); it++) {
+        std::vector<std::pair<Node_Id, double>> children;
+        for (const Node_Id neighbour_id : nodes.at(*it).neighbours) {
+            if (parent_of.at(*it) != neighbour_id)
+                children.push_back({neighbour_id, need_down.at(neighbour_id)});
+        }
+        sortChildren(children);
+        need_down[*it] = need(*it, children);
+    }
+
+    for (const Node_Id n_id : pre_order) {
+        std::vector<std::pair<Node_Id, double>> neighbours;
+        for (const Node_Id neighbour_id : nodes.at(n_id).neighbours)
+            neighbours.push_back({neighbour_id, parent_of.at(n_id) == neighbour_id ? need_up.at(n_id) : need_down.at(neighbour_id)});
+        sortChildren(neighbours);
+        peak_as_root[n_id] = need(n_id, neighbours);
+
+        // prefix[i] is the peak over the first i neighbours, suffix[i] the peak over the neighbours from i on.
+        const size_t d = neighbours.size();
+        std::vector<double> prefix(d + 1, 0);
+        std::vector<double> suffix(d + 1, 0);
+        double live = 0;
+        for (size_t i = 0; i < d; i++) {
+            prefix[i + 1] = std::max(prefix[i], live + neighbours[i].second);
+            live += table_entries.at(neighbours[i].first);
+        }
+        const double total_live = live;
+        for (size_t i = d; i-- > 0;) {
+            live -= table_entries.at(neighbours[i].first);
+            suffix[i] = std::max(suffix[i + 1], live + neighbours[i].second);
+        }
+        for (size_t i = 0; i < d; i++) {
+            const Node_Id neighbour_id = neighbours[i].first;
+            if (parent_of.at(n_id) == neighbour_id)
+                continue;
+            const double left_out = table_entries.at(neighbour_id);
+            need_up[neighbour_id] = std::max({prefix[i], suffix[i + 1] - left_out, total_live - left_out + table_entries.at(n_id)});
+        }
+    }
+
+    // Carry the entries over from the first root.
+    std::unordered_map<Node_Id, double> root_entries{{first_root, first_root_entries}};
+    for (const Node_Id n_id : pre_order) {
+        if (!parent_of.at(n_id).has_value())
+            continue;
+        const Node_Id parent_id = parent_of.at(n_id).value();
+        const size_t common = common_with_parent.at(n_id);
+        root_entries[n_id] = root_entries.at(parent_id)
+            - nodeCost(parent_id, degree(parent_id)) + nodeCost(parent_id, degree(parent_id) - 1)
+            - nodeCost(n_id, degree(n_id) - 1) + nodeCost(n_id, degree(n_id))
+            - edgeCost(parent_id, n_id, common) + edgeCost(n_id, parent_id, common);
+    }
+
+    for (const Node_Id n_id : pre_order)
+        costs[n_id] = root_entries.at(n_id) + model.peak_weight * peak_as_root.at(n_id);
+    return costs;
 }
 
 void TreeDecomposition::removeDuplicateNeighbours() {
@@ -360,16 +640,16 @@ void TreeDecomposition::removeDuplicateNeighbours() {
         // 1. Remove all edges incident to the child
         // 2. Add all former children to the children of this node.
         // 3. Delete the child.
-        const auto node = nodes.at(n_id);
+        const Node& node = nodes.at(n_id);
         if (node.children.size() != 1)
             return;
         
         Node_Id child_id = *node.children.begin();
         const Node& child = getNode(child_id);
-        
-        std::vector<Node_Id>childs_children{child.children.begin(), child.children.end()};
 
         if (node.bag == child.bag) {
+            // Only the ids of the child's children are copied, removing the child changes them.
+            std::vector<Node_Id>childs_children{child.children.begin(), child.children.end()};
             removeNode(child_id);
             for (auto& childs_child : childs_children) {
                 addEdge(n_id, childs_child);
@@ -382,6 +662,98 @@ const Node &TreeDecomposition::getNode(Node_Id n_id) const {
     return nodes.at(n_id);
 }
 
+TreeDecomposition TreeDecomposition::fromEliminationOrdering(const UndirectedGraph& graph, const std::vector<Vertex_Id>& ordering) {
+    TreeDecomposition td{graph};
+
+    const std::vector<Vertex_Id>& vertices = graph.getVertices();
+    const size_t number_of_ids = vertices.empty() ? 0 : *std::max_element(vertices.begin(), vertices.end()) + 1;
+    if (ordering.size() != vertices.size())
+        throw std::invalid_argument("The elimination ordering has to contain every vertex exactly once.");
+
+    std::vector<size_t> position(number_of_ids, ordering.size());
+    for (size_t i = 0; i < ordering.size(); i++) {
+        if (ordering[i] >= number_of_ids || position[ordering[i]] != ordering.size())
+            throw std::invalid_argument("The elimination ordering has to contain every vertex exactly once.");
+        position[ordering[i]] = i;
+    }
+
+    // Only the neighbours that are eliminated later are kept.
+    std::vector<std::unordered_set<Vertex_Id>> later_neighbours(number_of_ids);
+    for (const Vertex_Id v_id : vertices) {
+        for (const Vertex_Id u_id : graph.getNeighbours(v_id)) {
+            if (position[u_id] > position[v_id])
+                later_neighbours[v_id].insert(u_id);
+        }
+    }
+
+    // `next[v]` is the vertex whose bag the bag of v is attached to. A bag is merged into the bag of its child `absorbed_by[v]` if it is a subset of the latter, i.e. the child's later neighbours are exactly the bag.
+    std::vector<std::optional<Vertex_Id>> next(number_of_ids);
+    std::vector<std::optional<Vertex_Id>> absorbed_by(number_of_ids);
+    std::vector<size_t> largest_child_neighbourhood(number_of_ids, 0);
+    for (const Vertex_Id v_id : ordering) {
+        const std::unordered_set<Vertex_Id>& N = later_neighbours[v_id];
+        if (largest_child_neighbourhood[v_id] != N.size() + 1)
+            absorbed_by[v_id].reset();
+        if (N.empty())
+            continue;
+
+        const Vertex_Id next_id = *std::min_element(N.begin(), N.end(), [&position](Vertex_Id a, Vertex_Id b) { return position[a] < position[b]; });
+        for (const Vertex_Id u_id : N) {
+            if (u_id != next_id)
+                later_neighbours[next_id].insert(u_id);
+        }
+        next[v_id] = next_id;
+        if (N.size() > largest_child_neighbourhood[next_id]) {
+            largest_child_neighbourhood[next_id] = N.size();
+            absorbed_by[next_id] = v_id;
+        }
+    }
+
+    std::vector<Node_Id> node_of(number_of_ids);
+    for (const Vertex_Id v_id : ordering) {
+        if (absorbed_by[v_id].has_value()) {
+            node_of[v_id] = node_of[absorbed_by[v_id].value()];
+            continue;
+        }
+        node_of[v_id] = td.addNode(std::to_string(td.nodes.size() + 1));
+        Node& node = td.nodes.at(node_of[v_id]);
+        node.bag.insert(v_id);
+        node.bag.insert(later_neighbours[v_id].begin(), later_neighbours[v_id].end());
+    }
+
+    std::optional<Node_Id> previous_component;
+    for (const Vertex_Id v_id : ordering) {
+        if (!next[v_id].has_value()) {
+            // `v_id` is the last vertex of its connected component: Link the components into a single tree.
+            if (previous_component.has_value())
+                td.addEdge(previous_component.value(), node_of[v_id]);
+            previous_component = node_of[v_id];
+        }
+        else if (node_of[next[v_id].value()] != node_of[v_id]) {
+            td.addEdge(node_of[next[v_id].value()], node_of[v_id]);
+        }
+    }
+
+    if (ordering.empty())
+        td.addNode("1");
+
+    return td;
+}
+
+TreeDecomposition TreeDecomposition::mapVertices(const UndirectedGraph& graph, const std::vector<std::optional<Vertex_Id>>& vertex_map) const {
+    TreeDecomposition td = *this;
+    td.graph_ptr = &graph;
+    for (auto& [n_id, node] : td.nodes) {
+        Bag bag;
+        for (const Vertex_Id v_id : node.bag) {
+            if (vertex_map[v_id].has_value())
+                bag.insert(vertex_map[v_id].value());
+        }
+        node.bag = std::move(bag);
+    }
+    return td;
+}
+
 Node_Id TreeDecomposition::addNode()
 {
     return addNode("NEW_" + std::to_string(new_nodes_counter++));
@@ -405,11 +777,22 @@ Node_Id TreeDecomposition::addNode(std::string n_name) {
     return new_id;
 }
 
+Node_Id TreeDecomposition::addNode(std::string_view n_name, std::vector<std::optional<Node_Id>>& numeric_name_to_id) {
+    const std::optional<size_t> number = parseNumber<size_t>(n_name);
+    if (!number.has_value() || number.value() > 4 * numeric_name_to_id.size() + 1024 || (n_name.size() > 1 && n_name[0] == '0'))
+        return addNode(string(n_name));
+    if (number.value() >= numeric_name_to_id.size())
+        numeric_name_to_id.resize(number.value() + 1);
+    if (!numeric_name_to_id[number.value()].has_value())
+        numeric_name_to_id[number.value()] = addNode(string(n_name));
+    return numeric_name_to_id[number.value()].value();
+}
+
 void TreeDecomposition::removeNode(Node_Id n_id) {
     const Node& node = nodes.at(n_id);
 
     // 1. Remove all edges incident to the node-to-remove
-    removeEdge(n_id, node.parent.value());
+    removeEdge(node.parent.value(), n_id);
     std::vector<Node_Id> node_children{node.children.begin(), node.children.end()};
     for (const auto& child : node_children) {
         removeEdge(n_id, child);
@@ -427,6 +810,7 @@ void TreeDecomposition::addEdge(Node_Id n1_id, Node_Id n2_id) {
 
     // Add edge in edges
     edges.insert({std::min(n1_id, n2_id), std::max(n1_id, n2_id)});
+    invalidateSchedule();
 
     // If tree is rooted: Add edge in parents and children
     if (isRooted()) {
@@ -442,6 +826,7 @@ void TreeDecomposition::removeEdge(Node_Id n1_id, Node_Id n2_id) {
 
     // Remove edge in edges
     edges.erase({std::min(n1_id, n2_id), std::max(n1_id, n2_id)});
+    invalidateSchedule();
 
     // If tree is rooted: Remove edge in parents and children
     if (isRooted()) {
@@ -450,46 +835,43 @@ void TreeDecomposition::removeEdge(Node_Id n1_id, Node_Id n2_id) {
     }
 }
 
-void TreeDecomposition::doSomethingPreOrder(std::function<void(Node_Id)>f) const {
-    doSomethingPreOrder(f, getRoot());
-}
+/*
+Both orders come from one iterative depth-first search: Visiting every node before its children, with the children in reverse order, and reversing the result gives a post-order.
+*/
+std::shared_ptr<const TreeDecomposition::Schedule> TreeDecomposition::schedule() const {
+    if (cached_schedule)
+        return cached_schedule;
 
-void TreeDecomposition::doSomethingPreOrder(std::function<void(Node_Id)>f, Node_Id n_id) const {
-    f(n_id);
-    const auto& node = nodes.at(n_id);
-    const std::vector<Node_Id> children_copy{node.children.begin(), node.children.end()};
-    for (const Node_Id& child_id : children_copy) {
-        doSomethingPreOrder(f, child_id);
-    }
-}
+    auto new_schedule = std::make_shared<Schedule>();
+    new_schedule->pre_order.reserve(nodes.size());
+    new_schedule->post_order.reserve(nodes.size());
 
-void TreeDecomposition::doSomethingPostOrder(std::function<void(Node_Id)>f) const {
-    doSomethingPostOrder(f, getRoot());
-}
+    std::vector<Node_Id> to_visit{getRoot()};
+    while (!to_visit.empty()) {
+        const Node_Id n_id = to_visit.back();
+        to_visit.pop_back();
+        new_schedule->pre_order.push_back(n_id);
+        const auto& children = nodes.at(n_id).children;
+        to_visit.insert(to_visit.end(), children.begin(), children.end());
+        std::reverse(to_visit.end() - children.size(), to_visit.end());
+    }
 
-void TreeDecomposition::doSomethingPostOrder(std::function<void(Node_Id)>f, Node_Id n_id) const {
-    const auto node = nodes.at(n_id);
-    const std::vector<Node_Id> children_copy{node.children.begin(), node.children.end()};
-    for (const Node_Id child_id : children_copy) {
-        doSomethingPostOrder(f, child_id);
+    to_visit.push_back(getRoot());
+    while (!to_visit.empty()) {
+        const Node_Id n_id = to_visit.back();
+        to_visit.pop_back();
+        new_schedule->post_order.push_back(n_id);
+        const auto& children = nodes.at(n_id).children;
+        to_visit.insert(to_visit.end(), children.begin(), children.end());
     }
-    f(n_id);
-}
+    std::reverse(new_schedule->post_order.begin(), new_schedule->post_order.end());
 
-void TreeDecomposition::doWhilePreOrder(std::function<void(Node_Id)> f, std::function<bool()> pred) const {
-    doWhilePreOrder(f, pred, getRoot());
+    cached_schedule = std::move(new_schedule);
+    return cached_schedule;
 }
 
-void TreeDecomposition::doWhilePreOrder(std::function<void(Node_Id)> f, std::function<bool()> pred, Node_Id n_id) const {
-    if (!pred())
-        return;
-
-    f(n_id);
-    for (const Node_Id& child_id : nodes.at(n_id).children) {
-        if (!pred())
-            return;
-        f(child_id);
-    }
+void TreeDecomposition::invalidateSchedule() {
+    cached_schedule.reset();
 }
 
 std::ostream &operator<<(std::ostream &stream, const TreeDecomposition &td)
@@ -0,0 +1,519 @@
+#include "tree_decomposition_dp.h"
+#include "thread_pool.h"
+#include "min_weighted_vertex_cover.h"
+#include "max_weighted_independent_set.h"
+#include "three_coloring.h"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+// Bit positions of the vertices that a node and its child have in common (in both bags) and of those that only one of them has.
+struct BagChange {
+    std::vector<size_t> common_in_parent;
+    std::vector<size_t> common_in_child;
+    std::vector<size_t> introduced;
+    std::vector<size_t> forgotten;
+};
+
+static BagChange compareBags(std::span<const Vertex_Id> bag, std::span<const Vertex_Id> child_bag) {
+    BagChange change;
+    size_t i = 0, j = 0;
+    while (i < bag.size() || j < child_bag.size()) {
+        if (j == child_bag.size() || (i < bag.size() && bag[i] < child_bag[j])) {
+            change.introduced.push_back(i++);
+        }
+        else if (i == bag.size() || child_bag[j] < bag[i]) {
+            change.forgotten.push_back(j++);
+        }
+        else {
+            change.common_in_parent.push_back(i++);
+            change.common_in_child.push_back(j++);
+        }
+    }
+    return change;
+}
+
+// Returns the number of vertices two sorted bags have in common.
+static size_t countCommon(std::span<const Vertex_Id> bag, std::span<const Vertex_Id> child_bag) {
+    size_t common = 0;
+    for (size_t i = 0, j = 0; i < bag.size() && j < child_bag.size();) {
+        if (bag[i] < child_bag[j])
+            i++;
+        else if (child_bag[j] < bag[i])
+            j++;
+        else {
+            common++;
+            i++;
+            j++;
+        }
+    }
+    return common;
+}
+
+// Bit k of the result is bit `positions[k]` of `mask`.
+static Cover_Mask extractBits(Cover_Mask mask, const std::vector<size_t>& positions) {
+    Cover_Mask bits = 0;
+    for (size_t k = 0; k < positions.size(); k++)
+        bits |= (mask >> positions[k] & 1) << k;
+    return bits;
+}
+
+// Bit `positions[k]` of the result is bit k of `bits`.
+static Cover_Mask depositBits(Cover_Mask bits, const std::vector<size_t>& positions) {
+    Cover_Mask mask = 0;
+    for (size_t k = 0; k < positions.size(); k++)
+        mask |= (bits >> k & 1) << positions[k];
+    return mask;
+}
+
+/*
+Every node's table holds an entry for *all* assignments of states to its bag. Each assignment is addressed by its index, so that the introduce, forget and join steps become plain index arithmetic instead of lookups of hashed sets.
+
+The tables are discarded as soon as their parent is computed. If the problem has a witness, it is recovered afterwards by a top-down pass that only needs the choices made by the forget steps (see `reconstructSolution`).
+*/
+template<DPProblem Problem>
+typename Problem::Solution TreeDecompositionDP<Problem>::solve(size_t num_threads) {
+    checkTreeDecomposition();
+
+    live_entries = 0;
+    peak_live_entries = 0;
+    if (progress_callback) {
+        estimated_work = estimate().work;
+        done_work = 0;
+    }
+
+    if (num_threads > 1)
+        solveParallel(num_threads);
+    else
+        solveSequential();
+
+    const Table& root_table = M.at(td.getRoot());
+    size_t best_index = 0;
+    const Value value = Problem::aggregate(root_table.values.data(), root_table.size(), best_index);
+    M.clear();
+    arena.clear();
+
+    Vertex_Set selected;
+    if constexpr (Problem::HAS_WITNESS)
+        selected = reconstructSolution(best_index);
+    forget_choices.clear();
+    transition_choices.clear();
+
+    return Problem::makeSolution(std::move(selected), value);
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::checkTreeDecomposition() const {
+    if constexpr (!Problem::FUSED_TRANSITIONS) {
+        for (const Node_Id t_id : td.getPreOrder()) {
+            for (const Node_Id child_id : td.getChildren(t_id)) {
+                const BagChange change = compareBags(td.getBag(t_id), td.getBag(child_id));
+                if (change.introduced.size() + change.forgotten.size() > 1)
+                    throw std::invalid_argument("The bags of node " + std::to_string(t_id) + " and its child " + std::to_string(child_id) + " differ in more than one vertex. This problem requires a nice tree decomposition.");
+            }
+        }
+    }
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::solveSequential() {
+    for (const Node_Id t_id : memoryAwarePostOrder(predicted_peak_entries))
+        computeNode(t_id);
+}
+
+/*
+Let need(t) be the peak number of live entries while computing the subtree of t and size(t) the number of entries of t's table. If the children c_1, ..., c_k of t are computed in this order:
+    need(t) = max(max_i (size(c_1) + ... + size(c_{i-1}) + need(c_i)), size(c_1) + ... + size(c_k) + size(t))
+which is minimized by sorting the children by decreasing need(c_i) - size(c_i).
+*/
+template<DPProblem Problem>
+std::vector<Node_Id> TreeDecompositionDP<Problem>::memoryAwarePostOrder(double& predicted_peak_entries) const {
+    std::vector<double> need(td.idBound());
+    std::vector<std::vector<Node_Id>> ordered_children(td.idBound());
+    auto size = [this](Node_Id n_id) { return std::pow(double(Problem::STATES), double(td.getBag(n_id).size())); };
+
+    // Children come after their parent in the pre-order, thus in reverse they come before it.
+    const std::vector<Node_Id>& pre_order = td.getPreOrder();
+    for (auto it = pre_order.rbegin(); it != pre_order.rend(); it++) {
+        const Node_Id t_id = *it;
+        const std::span<const Node_Id> t_children = td.getChildren(t_id);
+        std::vector<Node_Id> children{t_children.begin(), t_children.end()};
+        std::sort(children.begin(), children.end(), [&need, &size](Node_Id c1, Node_Id c2) {
+            return need[c1] - size(c1) > need[c2] - size(c2);
+        });
+
+        double live = 0;
+        double peak = 0;
+        for (const Node_Id child_id : children) {
+            peak = std::max(peak, live + need[child_id]);
+            live += size(child_id);
+        }
+        need[t_id] = std::max(peak, live + size(t_id));
+        ordered_children[t_id] = std::move(children);
+    }
+
+    predicted_peak_entries = need[td.getRoot()];
+
+    // Iterative post-order over the ordered children.
+    std::vector<Node_Id> post_order;
+    std::vector<std::pair<Node_Id, size_t>> stack{{td.getRoot(), 0}};
+    while (!stack.empty()) {
+        auto& [n_id, next_child] = stack.back();
+        const auto& children = ordered_children[n_id];
+        if (next_child < children.size()) {
+            stack.push_back({children[next_child++], 0});
+        }
+        else {
+            post_order.push_back(n_id);
+            stack.pop_back();
+        }
+    }
+
+    return post_order;
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::setSpillOptions(const SpillOptions& options) {
+    spill_options = options;
+}
+
+template<DPProblem Problem>
+const TableArena<typename Problem::Value>& TreeDecompositionDP<Problem>::getArena() const {
+    return arena;
+}
+
+/*
+The work of a kernel is the number of entries it reads and writes, as all kernels are a single pass over their input and output tables. A node with k children runs up to k transitions and k - 1 joins. A transition that forgets and introduces more than one vertex goes through a table over the common vertices (see `computeTransition`).
+*/
+template<DPProblem Problem>
+double TreeDecompositionDP<Problem>::nodeWork(const Node_Id t_id, double& entries, double& choice_bytes) const {
+    const std::span<const Vertex_Id> bag = td.getBag(t_id);
+    // In double like `memoryAwarePostOrder`, as the size_t `tableSize` wraps around for bags that could never be solved.
+    auto size = [](size_t bag_size) { return std::pow(double(Problem::STATES), double(bag_size)); };
+    const double table_size = size(bag.size());
+
+    double work = 0;
+    choice_bytes = 0;
+    if (td.getChildren(t_id).empty()) {
+        // The introduce chain from the empty bag.
+        entries = 1;
+        for (size_t k = 1; k <= bag.size(); k++) {
+            entries += size(k);
+            work += size(k - 1) + size(k);
+        }
+        return work;
+    }
+
+    entries = table_size;
+    bool first_child = true;
+    for (const Node_Id child_id : td.getChildren(t_id)) {
+        const std::span<const Vertex_Id> child_bag = td.getBag(child_id);
+        const size_t common = countCommon(bag, child_bag);
+        const size_t differences = bag.size() + child_bag.size() - 2 * common;
+
+        if (!first_child) {
+            entries += table_size;
+            work += 3 * table_size;
+        }
+        first_child = false;
+
+        if (differences == 1) {
+            work += size(child_bag.size()) + table_size;
+            if (Problem::HAS_WITNESS && child_bag.size() > bag.size())
+                choice_bytes += std::ceil(table_size / 64) * sizeof(uint64_t);
+        }
+        else if (differences > 1) {
+            entries += size(common);
+            work += size(child_bag.size()) + 2 * size(common) + table_size;
+            if (Problem::HAS_WITNESS)
+                choice_bytes += size(common) * sizeof(uint32_t);
+        }
+    }
+    return work;
+}
+
+/*
+The parallel solve does not follow the memory-aware post-order: All leaves are ready from the start and the tables finished in one subtree wait for their parents while the threads work elsewhere, so any set of tables may be live at once. Thus the peak on several threads is bounded by the entries of all nodes' tables.
+*/
+template<DPProblem Problem>
+SolveEstimate TreeDecompositionDP<Problem>::estimate(size_t num_threads) const {
+    SolveEstimate estimate;
+    double choice_bytes = 0;
+    double table_entries = 0;
+    for (const Node_Id t_id : td.getPreOrder()) {
+        double entries, node_choice_bytes;
+        estimate.work += nodeWork(t_id, entries, node_choice_bytes);
+        estimate.total_entries += entries;
+        choice_bytes += node_choice_bytes;
+        table_entries += std::pow(double(Problem::STATES), double(td.getBag(t_id).size()));
+    }
+    if (num_threads <= 1)
+        memoryAwarePostOrder(estimate.peak_entries);
+    else
+        estimate.peak_entries = table_entries;
+    // The choices are kept until the solution is reconstructed.
+    estimate.peak_bytes = estimate.peak_entries * sizeof(Value) + choice_bytes;
+    return estimate;
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::setProgressCallback(std::function<void(double)> callback) {
+    progress_callback = std::move(callback);
+}
+
+template<DPProblem Problem>
+double TreeDecompositionDP<Problem>::getPredictedPeakEntries() const {
+    return predicted_peak_entries;
+}
+
+template<DPProblem Problem>
+size_t TreeDecompositionDP<Problem>::getObservedPeakEntries() const {
+    return peak_live_entries;
+}
+
+/*
+Every node becomes a task as soon as all of its children are computed: The leaves are submitted up front and the task finishing the last child of a node submits that node. Thus join nodes wait on both of their children while the subtrees below them are evaluated concurrently.
+*/
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::solveParallel(size_t num_threads) {
+    std::vector<Node_Id> leaves;
+    std::vector<std::atomic<size_t>> pending_children(td.idBound());
+    for (const Node_Id t_id : td.getPreOrder()) {
+        pending_children[t_id] = td.getChildren(t_id).size();
+        if (td.getChildren(t_id).empty())
+            leaves.push_back(t_id);
+    }
+
+    WorkStealingThreadPool pool{num_threads};
+
+    std::function<void(Node_Id)> compute_and_notify_parent;
+    compute_and_notify_parent = [this, &pool, &pending_children, &compute_and_notify_parent](const Node_Id t_id) {
+        computeNode(t_id);
+
+        const std::optional<Node_Id> parent = td.getParent(t_id);
+        if (!parent.has_value() || t_id == td.getRoot())
+            return;
+
+        Node_Id parent_id = parent.value();
+        if (--pending_children[parent_id] == 0)
+            pool.submit([parent_id, &compute_and_notify_parent]() { compute_and_notify_parent(parent_id); });
+    };
+
+    for (const Node_Id leaf_id : leaves)
+        pool.submit([leaf_id, &compute_and_notify_parent]() { compute_and_notify_parent(leaf_id); });
+    pool.wait();
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::computeNode(const Node_Id t_id) {
+    const std::span<const Node_Id> children = td.getChildren(t_id);
+    const std::span<const Vertex_Id> bag = td.getBag(t_id);
+
+    Table* table;
+    std::vector<Table*> child_tables;
+    {
+        std::lock_guard<std::mutex> lock(M_mutex);
+        table = &M[t_id];
+        for (const Node_Id child_id : children)
+            child_tables.push_back(&M.at(child_id));
+        live_entries += tableSize<Problem::STATES>(bag.size());
+        peak_live_entries = std::max(peak_live_entries, live_entries);
+    }
+
+    // update M here
+    table->bag.assign(bag.begin(), bag.end());
+
+    if (children.empty()) { // is a leaf node
+        computeLeaf(*table);
+    }
+    else { // introduce, forget or join node (or, in a tree decomposition that is not nice, any combination of them)
+        computeBagChange(*table, *child_tables[0], children[0]);
+        for (size_t i = 1; i < children.size(); i++) {
+            Table lifted{table->bag, {}};
+            computeBagChange(lifted, *child_tables[i], children[i]);
+            computeJoin(*table, lifted);
+            arena.recycle(std::move(lifted.values));
+        }
+    }
+
+    double work = 0;
+    if (progress_callback) {
+        double entries, choice_bytes;
+        work = nodeWork(t_id, entries, choice_bytes);
+    }
+
+    // remove all entries for the children to reclaim memory space.
+    std::lock_guard<std::mutex> lock(M_mutex);
+    if (progress_callback) {
+        done_work += work;
+        progress_callback(estimated_work > 0 ? std::min(done_work / estimated_work, 1.0) : 1.0);
+    }
+    for (const Node_Id child_id : children) {
+        live_entries -= M.at(child_id).size();
+        arena.recycle(std::move(M.at(child_id).values));
+        M.erase(child_id);
+    }
+}
+
+template<DPProblem Problem>
+Vertex_Set TreeDecompositionDP<Problem>::reconstructSolution(size_t root_index) const {
+    Vertex_Set selected;
+    std::unordered_map<Node_Id, Cover_Mask> masks{{td.getRoot(), root_index}};
+
+    for (const Node_Id t_id : td.getPreOrder()) {
+        const Cover_Mask U = masks.at(t_id);
+        masks.erase(t_id);
+
+        const std::span<const Vertex_Id> bag = td.getBag(t_id);
+        for (size_t i = 0; i < bag.size(); i++) {
+            if (U >> i & 1)
+                selected.insert(bag[i]);
+        }
+
+        for (const Node_Id child_id : td.getChildren(t_id)) {
+            const BagChange change = compareBags(bag, td.getBag(child_id));
+
+            if (change.introduced.empty() && change.forgotten.empty()) {
+                masks[child_id] = U;
+            }
+            else if (change.introduced.size() == 1 && change.forgotten.empty()) {
+                masks[child_id] = removeBit(U, change.introduced[0]);
+            }
+            else if (change.introduced.empty() && change.forgotten.size() == 1) {
+                masks[child_id] = insertBit(U, change.forgotten[0], getChoice(forget_choices.at(child_id), U));
+            }
+            else {
+                const Cover_Mask common = extractBits(U, change.common_in_parent);
+                masks[child_id] = depositBits(common, change.common_in_child) | depositBits(transition_choices.at(child_id)[common], change.forgotten);
+            }
+        }
+    }
+
+    return selected;
+}
+
+template<DPProblem Problem>
+Cover_Mask TreeDecompositionDP<Problem>::neighbourMask(const Table& table, Vertex_Id v_id) const {
+    Cover_Mask mask = 0;
+    for (size_t i = 0; i < table.bag.size(); i++) {
+        if (graph.areNeighbours(table.bag[i], v_id))
+            mask |= Cover_Mask{1} << i;
+    }
+    return mask;
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::computeLeaf(Table& table) {
+    Table partial{{}, arena.acquire(1, spill_options)};
+    partial.values[0] = Problem::emptyBag();
+
+    // The bag is sorted, thus every vertex is introduced at the highest position.
+    for (const Vertex_Id v_id : table.bag) {
+        Table extended{partial.bag, {}};
+        extended.bag.push_back(v_id);
+        computeIntroduce(extended, partial, v_id);
+        arena.recycle(std::move(partial.values));
+        partial = std::move(extended);
+    }
+
+    table.values = std::move(partial.values);
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::computeIntroduce(Table& table, const Table& child, Vertex_Id v_id) {
+    // The neighbours of v in the bag are looked up once per node instead of once per entry.
+    const Cover_Mask neighbours = neighbourMask(child, v_id);
+
+    table.values = arena.acquire(table.size(), spill_options);
+    Problem::introduce(child.values.data(), table.values.data(), child.size(), table.position(v_id), neighbours, graph.getWeight(v_id));
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::computeForget(Table& table, const Table& child, Vertex_Id v_id, SpillableBuffer<uint64_t>& choices) {
+    table.values = arena.acquire(table.size(), spill_options);
+    uint64_t* choice_bits = nullptr;
+    if constexpr (Problem::HAS_WITNESS) {
+        choices.allocate((table.size() + 63) / 64, spill_options);
+        std::fill(choices.begin(), choices.end(), 0);
+        choice_bits = choices.data();
+    }
+    Problem::forget(child.values.data(), table.values.data(), choice_bits, table.size(), child.position(v_id));
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::computeTransition(Table& table, const Table& child, SpillableBuffer<uint32_t>& choices) {
+    // Only instantiated for problems that provide forgetMany and introduceMany.
+    if constexpr (Problem::FUSED_TRANSITIONS) {
+        const BagChange change = compareBags(table.bag, child.bag);
+
+        // Forget: The best child entry for every assignment to the common vertices.
+        SpillableBuffer<Value> common_values = arena.acquire(size_t{1} << change.common_in_child.size(), spill_options);
+        choices.allocate(common_values.size(), spill_options);
+        const BitProjection child_to_common{child.bag.size(), change.common_in_child};
+        const BitProjection child_to_forgotten{child.bag.size(), change.forgotten};
+        Problem::forgetMany(child.values.data(), child.size(), child_to_common, child_to_forgotten, common_values.data(), common_values.size(), choices.data());
+
+        // Introduce: Extend these entries by every assignment to the introduced vertices.
+        std::vector<Vertex_Weight> introduced_weights;
+        std::vector<Cover_Mask> introduced_neighbour_masks;
+        for (const size_t pos : change.introduced) {
+            introduced_weights.push_back(graph.getWeight(table.bag[pos]));
+            introduced_neighbour_masks.push_back(neighbourMask(table, table.bag[pos]));
+        }
+
+        table.values = arena.acquire(table.size(), spill_options);
+        const BitProjection parent_to_common{table.bag.size(), change.common_in_parent};
+        const BitProjection parent_to_introduced{table.bag.size(), change.introduced};
+        Problem::introduceMany(common_values.data(), table.values.data(), table.size(), parent_to_common, parent_to_introduced, introduced_weights, introduced_neighbour_masks);
+
+        arena.recycle(std::move(common_values));
+    }
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::computeBagChange(Table& table, Table& child, Node_Id child_id) {
+    const BagChange change = compareBags(table.bag, child.bag);
+
+    if (change.introduced.empty() && change.forgotten.empty()) {
+        table.values = std::move(child.values);
+    }
+    else if (change.introduced.size() == 1 && change.forgotten.empty()) {
+        computeIntroduce(table, child, table.bag[change.introduced[0]]);
+    }
+    else if (change.introduced.empty() && change.forgotten.size() == 1) {
+        SpillableBuffer<uint64_t>* choices;
+        {
+            std::lock_guard<std::mutex> lock(M_mutex);
+            choices = &forget_choices[child_id];
+        }
+        computeForget(table, child, child.bag[change.forgotten[0]], *choices);
+    }
+    else if constexpr (Problem::FUSED_TRANSITIONS) {
+        SpillableBuffer<uint32_t>* choices;
+        {
+            std::lock_guard<std::mutex> lock(M_mutex);
+            choices = &transition_choices[child_id];
+        }
+        computeTransition(table, child, *choices);
+    }
+}
+
+template<DPProblem Problem>
+void TreeDecompositionDP<Problem>::computeJoin(Table& table, const Table& other) {
+    std::vector<Vertex_Weight> bag_weights;
+    for (const Vertex_Id v_id : table.bag)
+        bag_weights.push_back(graph.getWeight(v_id));
+
+    // Every entry only depends on the entries of both tables at the same index, thus it can be overwritten in place.
+    Problem::join(table.values.data(), other.values.data(), table.values.data(), table.size(), bag_weights);
+}
+
+std::ostream& operator<<(std::ostream& os, const SolveEstimate& estimate) {
+    return os << "(" << estimate.total_entries << "," << estimate.work << "," << estimate.peak_entries << "," << estimate.peak_bytes << ")";
+}
+
+// One instantiation per problem, the kernels of every problem are compiled into its own engine.
+template class TreeDecompositionDP<VertexCoverProblem>;
+template class TreeDecompositionDP<IndependentSetProblem>;
+template class TreeDecompositionDP<ThreeColoringProblem>;
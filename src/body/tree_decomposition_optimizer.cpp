@@ -0,0 +1,228 @@
+#include "tree_decomposition_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+double DecompositionCostModel::tableEntries(size_t bag_size) const {
+    return std::pow(static_cast<double>(states), static_cast<double>(bag_size));
+}
+
+/*
+Returns the peak number of live entries while computing a table of `entries` entries from the tables of its children, given as (need, entries), where the need of a child is the peak of its own subtree. The children are computed as in a memory-aware post-order (see `TreeDecompositionDP::memoryAwarePostOrder`), by decreasing need minus entries, and `children` is sorted accordingly.
+*/
+static double peakLiveEntries(std::vector<std::pair<double, double>>& children, double entries) {
+    std::sort(children.begin(), children.end(), [](const auto& c1, const auto& c2) {
+        return c1.first - c1.second > c2.first - c2.second;
+    });
+    double live = 0;
+    double peak = 0;
+    for (const auto& [child_need, child_entries] : children) {
+        peak = std::max(peak, live + child_need);
+        live += child_entries;
+    }
+    return std::max(peak, live + entries);
+}
+
+double decompositionCost(const TreeDecomposition& td, const DecompositionCostModel& model) {
+    TreeDecomposition rooted_td = td;
+    if (!rooted_td.isRooted())
+        rooted_td.rootTree();
+
+    double total_entries = 0;
+    double peak_entries = 0;
+    std::unordered_map<Node_Id, double> need;
+    std::vector<std::pair<double, double>> children;
+    rooted_td.doSomethingPostOrder([&](Node_Id n_id) {
+        const Node& node = rooted_td.getNode(n_id);
+        const double entries = model.tableEntries(node.bag.size());
+        total_entries += entries;
+
+        children.clear();
+        for (const Node_Id child_id : node.children)
+            children.push_back({need.at(child_id), model.tableEntries(rooted_td.getNode(child_id).bag.size())});
+        need[n_id] = peakLiveEntries(children, entries);
+        // The need of the root is the largest.
+        peak_entries = std::max(peak_entries, need[n_id]);
+    });
+    return model.cost(total_entries, peak_entries);
+}
+
+std::vector<Vertex_Id> eliminationOrderingOf(const UndirectedGraph& graph, const TreeDecomposition& td) {
+    TreeDecomposition rooted_td = td;
+    if (!rooted_td.isRooted())
+        rooted_td.rootTree();
+
+    const std::vector<Vertex_Id>& vertices = graph.getVertices();
+    const size_t number_of_ids = vertices.empty() ? 0 : *std::max_element(vertices.begin(), vertices.end()) + 1;
+    std::vector<bool> eliminated(number_of_ids, false);
+
+    std::vector<Vertex_Id> ordering;
+    ordering.reserve(vertices.size());
+    rooted_td.doSomethingPostOrder([&](Node_Id n_id) {
+        const Node& node = rooted_td.getNode(n_id);
+        const Bag* parent_bag = node.parent.has_value() ? &rooted_td.getNode(node.parent.value()).bag : nullptr;
+        for (const Vertex_Id v_id : node.bag) {
+            if (!eliminated[v_id] && (parent_bag == nullptr || !parent_bag->contains(v_id))) {
+                eliminated[v_id] = true;
+                ordering.push_back(v_id);
+            }
+        }
+    });
+
+    // Only vertices missing from an invalid `td` are left.
+    for (const Vertex_Id v_id : vertices) {
+        if (!eliminated[v_id])
+            ordering.push_back(v_id);
+    }
+    return ordering;
+}
+
+/*
+Evaluates the cost of the tree decomposition induced by elimination orderings without building it. Bags are computed and merged as in `TreeDecomposition::fromEliminationOrdering`, and the evaluation stops as soon as the cost exceeds `bound`.
+The peak is that of the induced tree decomposition rooted at the bag of the last vertex, which may differ from the root `decompositionCost` picks.
+*/
+class OrderingEvaluator {
+public:
+    OrderingEvaluator(const UndirectedGraph& graph, const DecompositionCostModel& model_) : model(model_) {
+        const std::vector<Vertex_Id>& vertices = graph.getVertices();
+        const size_t number_of_ids = vertices.empty() ? 0 : *std::max_element(vertices.begin(), vertices.end()) + 1;
+        neighbours.resize(number_of_ids);
+        for (const Vertex_Id v_id : vertices) {
+            for (const Vertex_Id u_id : graph.getNeighbours(v_id)) {
+                if (u_id != v_id)
+                    neighbours[v_id].push_back(u_id);
+            }
+        }
+        position.resize(number_of_ids);
+        later_neighbours.resize(number_of_ids);
+        largest_child_neighbourhood.resize(number_of_ids);
+        absorbed_by.resize(number_of_ids);
+        children.resize(number_of_ids);
+        need.resize(number_of_ids);
+    }
+
+    double cost(const std::vector<Vertex_Id>& ordering, double bound) {
+        for (size_t i = 0; i < ordering.size(); i++)
+            position[ordering[i]] = i;
+        for (const Vertex_Id v_id : ordering) {
+            later_neighbours[v_id].clear();
+            for (const Vertex_Id u_id : neighbours[v_id]) {
+                if (position[u_id] > position[v_id])
+                    later_neighbours[v_id].insert(u_id);
+            }
+        }
+
+        for (const Vertex_Id v_id : ordering) {
+            largest_child_neighbourhood[v_id] = 0;
+            children[v_id].clear();
+        }
+
+        double total_entries = 0;
+        double peak_entries = 0;
+        std::optional<Vertex_Id> previous_component;
+        for (const Vertex_Id v_id : ordering) {
+            const std::unordered_set<Vertex_Id>& N = later_neighbours[v_id];
+            const double entries = model.tableEntries(N.size() + 1);
+            // The components are linked into a single tree below the last one.
+            if (N.empty() && previous_component.has_value())
+                children[v_id].push_back({need[previous_component.value()], model.tableEntries(later_neighbours[previous_component.value()].size() + 1)});
+
+            if (largest_child_neighbourhood[v_id] == N.size() + 1) {
+                // The bag is merged into the bag of its child, which takes over the children of both and costs nothing more.
+                const Vertex_Id child_id = absorbed_by[v_id];
+                std::vector<std::pair<double, double>>& merged = children[v_id];
+                merged.erase(std::find(merged.begin(), merged.end(), std::pair{need[child_id], entries}));
+                merged.insert(merged.end(), children[child_id].begin(), children[child_id].end());
+            }
+            else {
+                total_entries += entries;
+            }
+            need[v_id] = peakLiveEntries(children[v_id], entries);
+            peak_entries = std::max(peak_entries, need[v_id]);
+            if (model.cost(total_entries, peak_entries) > bound)
+                return std::numeric_limits<double>::infinity();
+
+            if (N.empty()) {
+                previous_component = v_id;
+                continue;
+            }
+
+            const Vertex_Id next_id = *std::min_element(N.begin(), N.end(), [this](Vertex_Id a, Vertex_Id b) { return position[a] < position[b]; });
+            for (const Vertex_Id u_id : N) {
+                if (u_id != next_id)
+                    later_neighbours[next_id].insert(u_id);
+            }
+            children[next_id].push_back({need[v_id], entries});
+            if (N.size() > largest_child_neighbourhood[next_id]) {
+                largest_child_neighbourhood[next_id] = N.size();
+                absorbed_by[next_id] = v_id;
+            }
+        }
+        return model.cost(total_entries, peak_entries);
+    }
+
+private:
+    const DecompositionCostModel& model;
+    std::vector<std::vector<Vertex_Id>> neighbours;
+    std::vector<size_t> position;
+    std::vector<std::unordered_set<Vertex_Id>> later_neighbours;
+    std::vector<size_t> largest_child_neighbourhood;
+    std::vector<Vertex_Id> absorbed_by;
+    // The (need, entries) of the children of the bag of each vertex and the peak of its subtree, as in `decompositionCost`.
+    std::vector<std::vector<std::pair<double, double>>> children;
+    std::vector<double> need;
+};
+
+TreeDecomposition optimizeTreeDecomposition(const UndirectedGraph& graph, const TreeDecomposition& td, const OptimizerOptions& options) {
+    const auto deadline = std::chrono::steady_clock::now() + options.time_budget;
+    const double initial_cost = decompositionCost(td, options.cost_model);
+
+    std::vector<Vertex_Id> ordering = eliminationOrderingOf(graph, td);
+    OrderingEvaluator evaluator{graph, options.cost_model};
+    double current_cost = evaluator.cost(ordering, std::numeric_limits<double>::infinity());
+
+    std::vector<Vertex_Id> best_ordering = ordering;
+    double best_cost = current_cost;
+
+    std::mt19937_64 random{options.seed};
+    std::vector<Vertex_Id> candidate;
+    while (ordering.size() >= 2 && std::chrono::steady_clock::now() < deadline) {
+        // Moves a vertex by up to `window` positions. Short moves mostly reshape a few neighbouring bags, long ones re-attach whole subtrees.
+        const size_t window = std::uniform_int_distribution<size_t>{0, 3}(random) == 0 ? ordering.size() : 8;
+        const size_t from = std::uniform_int_distribution<size_t>{0, ordering.size() - 1}(random);
+        const size_t lowest = from >= window ? from - window : 0;
+        const size_t highest = std::min(ordering.size() - 1, from + window);
+        const size_t to = std::uniform_int_distribution<size_t>{lowest, highest}(random);
+        if (from == to)
+            continue;
+
+        candidate = ordering;
+        if (from < to)
+            std::rotate(candidate.begin() + from, candidate.begin() + from + 1, candidate.begin() + to + 1);
+        else
+            std::rotate(candidate.begin() + to, candidate.begin() + from, candidate.begin() + from + 1);
+
+        // Equally expensive orderings are accepted as well to move across plateaus.
+        const double candidate_cost = evaluator.cost(candidate, current_cost);
+        if (candidate_cost > current_cost)
+            continue;
+
+        ordering.swap(candidate);
+        current_cost = candidate_cost;
+        if (current_cost < best_cost) {
+            best_cost = current_cost;
+            best_ordering = ordering;
+        }
+    }
+
+    // The evaluator roots the induced tree decomposition at the bag of the last vertex rather than as `decompositionCost` does, so both are compared by the latter.
+    TreeDecomposition best_td = TreeDecomposition::fromEliminationOrdering(graph, best_ordering);
+    if (decompositionCost(best_td, options.cost_model) >= initial_cost)
+        return td;
+    return best_td;
+}
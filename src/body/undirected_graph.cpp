@@ -1,61 +1,154 @@
 #include "undirected_graph.h"
 #include "util.h"
+#include "mapped_file.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
 
 using std::string;
 
-/*
-Given the path to a CSV file, parses that file as an `UndirectedGraph` object.
+// The file is memory-mapped and scanned in place, names are only copied once per vertex.
+UndirectedGraph UndirectedGraph::parseUnsafe(const string& input_path) {
+    const MappedFile input{input_path};
+
+    const bool is_pace = endsWith(input_path, ".gr") || (!endsWith(input_path, ".csv") && firstContentLine(input.contents(), 'c').starts_with("p "));
+    return is_pace ? parsePace(input.contents()) : parseCsv(input.contents());
+}
 
+/*
 I. a,b     ... Undirected, unlabelled edge
 II. a,,20   ... Label vertex (i.e. set weight)
 */
-UndirectedGraph UndirectedGraph::parseUnsafe(const string& input_path) {
-    std::ifstream input(input_path);
-    if (!input)
-        throw std::invalid_argument::exception();
-
+UndirectedGraph UndirectedGraph::parseCsv(std::string_view contents) {
     UndirectedGraph graph;
 
-    string line;
-    while (getline(input, line)) {
-        if (line == "")
-            continue;
-        
-        std::vector<string> comma_parts = stringSplit(line, ',');
-        const std::string& v1_name = comma_parts[0];
-        const std::string& v2_name = comma_parts[1];
-        if (comma_parts.size() == 2) { // Case I
-            Vertex_Id v1_id = graph.addVertex(v1_name);
-            Vertex_Id v2_id = graph.addVertex(v2_name);
+    forEachLine(contents, [&graph](std::string_view line) {
+        std::string_view comma_parts[3];
+        size_t number_of_parts = 0;
+        forEachToken(line, ',', [&comma_parts, &number_of_parts](std::string_view part) {
+            if (number_of_parts < 3)
+                comma_parts[number_of_parts] = part;
+            number_of_parts++;
+        });
+
+        if (number_of_parts == 2) { // Case I
+            Vertex_Id v1_id = graph.addVertex(comma_parts[0]);
+            Vertex_Id v2_id = graph.addVertex(comma_parts[1]);
             graph.addEdge(v1_id, v2_id);
         }
-        else if (comma_parts.size() == 3) { // Case II
-            const std::string& label = comma_parts[2];
-            Vertex_Id v_id = graph.addVertex(v1_name);
-            graph.setWeight(v_id, std::stoi(label)); // immediately parse as number (double)
+        else if (number_of_parts == 3) { // Case II
+            // Like std::stoi, only the leading integer counts (a weight of 2.5 is read as 2), and weights out of range are rejected.
+            Vertex_Weight weight = 0;
+            const std::string_view label = comma_parts[2];
+            const auto [ptr, ec] = std::from_chars(label.data(), label.data() + label.size(), weight);
+            if (ec == std::errc::result_out_of_range)
+                throw std::out_of_range("Weight " + string(label) + " is out of range.");
+            if (ec != std::errc{})
+                throw std::invalid_argument("Invalid weight " + string(label) + ".");
+            Vertex_Id v_id = graph.addVertex(comma_parts[0]);
+            graph.setWeight(v_id, weight);
         }
         else {
-            throw std::invalid_argument::exception();
+            throw std::invalid_argument("Invalid line " + string(line) + ".");
         }
-    }
+    });
 
+    graph.freeze();
     return graph;
 }
 
+/*
+PACE 2017 treewidth format:
+    c ...        ... Comment
+    p tw n m     ... Header: The vertices are 1, ..., n
+    a b          ... Undirected edge
+The vertices get their ids in the order of their first appearance in an edge, just like in the CSV files converted by reformat.py, followed by the isolated ones.
+*/
+UndirectedGraph UndirectedGraph::parsePace(std::string_view contents) {
+    UndirectedGraph graph;
+    std::optional<size_t> number_of_vertices;
+
+    forEachLine(contents, [&graph, &number_of_vertices](std::string_view line) {
+        if (line[0] == 'c')
+            return;
+
+        std::string_view parts[4];
+        size_t number_of_parts = 0;
+        forEachToken(line, ' ', [&parts, &number_of_parts](std::string_view part) {
+            if (part.empty())
+                return;
+            if (number_of_parts < 4)
+                parts[number_of_parts] = part;
+            number_of_parts++;
+        });
+
+        if (parts[0] == "p") {
+            if (number_of_parts != 4 || parts[1] != "tw" || !parseNumber<size_t>(parts[2]).has_value())
+                throw std::invalid_argument("Invalid header " + string(line) + ".");
+            number_of_vertices = parseNumber<size_t>(parts[2]);
+        }
+        else if (number_of_parts == 2 && number_of_vertices.has_value()) {
+            const std::optional<size_t> v1 = parseNumber<size_t>(parts[0]);
+            const std::optional<size_t> v2 = parseNumber<size_t>(parts[1]);
+            if (!v1.has_value() || !v2.has_value() || v1 == 0 || v2 == 0 || v1 > number_of_vertices || v2 > number_of_vertices)
+                throw std::invalid_argument("Invalid edge " + string(line) + ".");
+            // Names are written canonically, so that e.g. 07 and 7 are the same vertex.
+            auto vertex = [&graph](std::string_view name, size_t v) { return name[0] == '0' ? graph.addVertex(std::to_string(v)) : graph.addVertex(name); };
+            const Vertex_Id v1_id = vertex(parts[0], v1.value());
+            const Vertex_Id v2_id = vertex(parts[1], v2.value());
+            graph.addEdge(v1_id, v2_id);
+        }
+        else {
+            throw std::invalid_argument("Invalid line " + string(line) + ".");
+        }
+    });
+
+    if (!number_of_vertices.has_value())
+        throw std::invalid_argument("Missing \"p tw\" header.");
+
+    for (size_t v = 1; v <= number_of_vertices.value(); v++)
+        graph.addVertex(std::to_string(v));
+    for (const Vertex_Id v_id : graph.vertices)
+        graph.setWeight(v_id, 1);
+
+    graph.freeze();
+    return graph;
+}
+
+// Returns the integer `name` stands for if it is written canonically (no sign, no leading zeros) and small enough to index a dense table.
+static std::optional<size_t> denseNumericName(std::string_view name) {
+    constexpr size_t MAX_DENSE_NAME = size_t{1} << 24;
+    if (name.empty() || (name.size() > 1 && name[0] == '0'))
+        return std::nullopt;
+    const std::optional<size_t> number = parseNumber<size_t>(name);
+    if (!number.has_value() || number.value() >= MAX_DENSE_NAME)
+        return std::nullopt;
+    return number;
+}
+
 std::string UndirectedGraph::idToName(Vertex_Id v_id) const {
     return vertex_id_to_name.at(v_id);
 }
 
-Vertex_Id UndirectedGraph::nameToId(const std::string &name) const
+Vertex_Id UndirectedGraph::nameToId(std::string_view name) const
 {
-    if (!vertex_name_to_id.contains(name)) {
-        throw std::invalid_argument("Does not know " + name);
+    const std::optional<Vertex_Id> v_id = findVertex(name);
+    if (!v_id.has_value()) {
+        throw std::invalid_argument("Does not know " + string(name));
     }
-    return vertex_name_to_id.at(name);
+    return v_id.value();
+}
+
+std::optional<Vertex_Id> UndirectedGraph::findVertex(std::string_view name) const {
+    // Numeric names that were too sparse for the dense table when they were added are hashed.
+    const std::optional<size_t> number = denseNumericName(name);
+    if (number.has_value() && number.value() < numeric_name_to_id.size() && numeric_name_to_id[number.value()] != NO_VERTEX)
+        return numeric_name_to_id[number.value()];
+
+    const auto it = vertex_name_to_id.find(string(name));
+    return it != vertex_name_to_id.end() ? std::optional{it->second} : std::nullopt;
 }
 
 size_t UndirectedGraph::numberOfNodes() const {
@@ -78,31 +171,65 @@ const Vertex_Weight UndirectedGraph::getWeight(Vertex_Id v_id) const {
     return vertex_id_to_weight[v_id];
 }
 
-const std::vector<Vertex_Id>& UndirectedGraph::getNeighbours(Vertex_Id v_id) const {
-    return adjacencies.at(v_id);
+std::span<const Vertex_Id> UndirectedGraph::getNeighbours(Vertex_Id v_id) const {
+    return std::span<const Vertex_Id>(neighbours).subspan(neighbour_offsets[v_id], neighbour_offsets[v_id + 1] - neighbour_offsets[v_id]);
 }
 
+// Without the adjacency matrix, the shorter of the two neighbour lists is searched.
 bool UndirectedGraph::areNeighbours(Vertex_Id v_id1, Vertex_Id v_id2) const {
-    return contains(adjacencies[v_id1], v_id2);
+    if (!adjacency_matrix.empty())
+        return (adjacency_matrix[v_id1 * matrix_row_words + v_id2 / 64] >> (v_id2 % 64)) & 1;
+
+    if (neighbour_offsets[v_id1 + 1] - neighbour_offsets[v_id1] > neighbour_offsets[v_id2 + 1] - neighbour_offsets[v_id2])
+        std::swap(v_id1, v_id2);
+    const std::span<const Vertex_Id> row = getNeighbours(v_id1);
+    return std::binary_search(row.begin(), row.end(), v_id2);
+}
+
+UndirectedGraph UndirectedGraph::reducedGraph(const std::vector<Vertex_Id>& kept_vertices, const std::vector<Edge>& new_edges, const std::vector<Vertex_Weight>& weights) const {
+    UndirectedGraph reduced;
+    reduced.vertices = kept_vertices;
+    reduced.vertex_id_to_name = vertex_id_to_name;
+    reduced.vertex_id_to_weight = weights;
+    reduced.vertex_name_to_id = vertex_name_to_id;
+    reduced.numeric_name_to_id = numeric_name_to_id;
+    reduced.next_free_id = next_free_id;
+
+    for (const auto& [v_id1, v_id2] : new_edges)
+        reduced.addEdge(v_id1, v_id2);
+    reduced.freeze();
+
+    return reduced;
 }
 
-Vertex_Id UndirectedGraph::addVertex(const string &v_name) {
-    Vertex_Id new_id;
-    if (!vertex_name_to_id.contains(v_name)) {
-        new_id = next_free_id++;
+Vertex_Id UndirectedGraph::addVertex(std::string_view v_name) {
+    const std::optional<Vertex_Id> existing_id = findVertex(v_name);
+    if (existing_id.has_value())
+        return existing_id.value();
 
-        vertices.push_back(new_id);
-        adjacencies.push_back({});
+    Vertex_Id new_id = next_free_id++;
 
-        vertex_id_to_name.push_back(v_name);
-        vertex_id_to_weight.push_back({});
-        vertex_name_to_id.insert({v_name, new_id});
+    vertices.push_back(new_id);
+
+    vertex_id_to_name.emplace_back(v_name);
+    vertex_id_to_weight.push_back({});
+    indexName(new_id);
+
+    return new_id;
+}
+
+// As in `TreeDecomposition::addNode`, sparse names are hashed instead. The bound follows the number of vertices up to `v_id`, so that a few growing names cannot inflate the table step by step either.
+void UndirectedGraph::indexName(Vertex_Id v_id) {
+    const std::string& v_name = vertex_id_to_name[v_id];
+    const std::optional<size_t> number = denseNumericName(v_name);
+    if (number.has_value() && number.value() <= 4 * (v_id + 1) + 1024) {
+        if (number.value() >= numeric_name_to_id.size())
+            numeric_name_to_id.resize(std::max(number.value() + 1, 2 * numeric_name_to_id.size()), NO_VERTEX);
+        numeric_name_to_id[number.value()] = v_id;
     }
     else {
-        new_id = vertex_name_to_id.at(v_name);
+        vertex_name_to_id.insert({v_name, v_id});
     }
-
-    return new_id;
 }
 
 void UndirectedGraph::setWeight(Vertex_Id v_id, Vertex_Weight label) {
@@ -110,21 +237,72 @@ void UndirectedGraph::setWeight(Vertex_Id v_id, Vertex_Weight label) {
 }
 
 void UndirectedGraph::addEdge(Vertex_Id v1_id, Vertex_Id v2_id) {
-    adjacencies[v1_id].push_back(v2_id);
-    adjacencies[v2_id].push_back(v1_id);
     edges.push_back({std::min(v1_id, v2_id), std::max(v1_id, v2_id)});
 }
 
+/*
+The edges are distributed into their rows by a counting sort, then every row is sorted and duplicate edges are dropped.
+*/
+void UndirectedGraph::freeze() {
+    const size_t number_of_ids = next_free_id;
+    neighbour_offsets.assign(number_of_ids + 1, 0);
+    for (const auto& [v_id1, v_id2] : edges) {
+        neighbour_offsets[v_id1 + 1]++;
+        if (v_id1 != v_id2)
+            neighbour_offsets[v_id2 + 1]++;
+    }
+    for (size_t v_id = 0; v_id < number_of_ids; v_id++)
+        neighbour_offsets[v_id + 1] += neighbour_offsets[v_id];
+
+    neighbours.resize(neighbour_offsets.back());
+    std::vector<size_t> next_position(neighbour_offsets.begin(), neighbour_offsets.end() - 1);
+    for (const auto& [v_id1, v_id2] : edges) {
+        neighbours[next_position[v_id1]++] = v_id2;
+        if (v_id1 != v_id2)
+            neighbours[next_position[v_id2]++] = v_id1;
+    }
+
+    size_t end = 0;
+    for (size_t v_id = 0; v_id < number_of_ids; v_id++) {
+        const auto row_begin = neighbours.begin() + neighbour_offsets[v_id];
+        const auto row_end = neighbours.begin() + neighbour_offsets[v_id + 1];
+        std::sort(row_begin, row_end);
+        const auto unique_end = std::unique(row_begin, row_end);
+        neighbour_offsets[v_id] = end;
+        end = std::move(row_begin, unique_end, neighbours.begin() + end) - neighbours.begin();
+    }
+    neighbour_offsets[number_of_ids] = end;
+    neighbours.resize(end);
+    neighbours.shrink_to_fit();
+
+    indexNeighbours();
+}
+
+void UndirectedGraph::indexNeighbours() {
+    const size_t number_of_ids = neighbour_offsets.size() - 1;
+    adjacency_matrix.clear();
+    matrix_row_words = 0;
+    if (number_of_ids > MAX_MATRIX_IDS)
+        return;
+
+    matrix_row_words = (number_of_ids + 63) / 64;
+    adjacency_matrix.assign(number_of_ids * matrix_row_words, 0);
+    for (Vertex_Id v_id1 = 0; v_id1 < number_of_ids; v_id1++) {
+        for (const Vertex_Id v_id2 : getNeighbours(v_id1))
+            adjacency_matrix[v_id1 * matrix_row_words + v_id2 / 64] |= uint64_t{1} << (v_id2 % 64);
+    }
+}
+
 std::ostream& operator<<(std::ostream& stream, const UndirectedGraph& graph) {
     stream << graph.numberOfNodes() << " vertices, " << graph.numberOfEdges() << " edges." << std::endl;
     stream << "vertex labels:" << std::endl;
-    for (Vertex_Id v_id = 0; v_id < graph.numberOfNodes(); v_id++) {
+    for (const Vertex_Id v_id : graph.vertices) {
         stream << "    " << graph.vertex_id_to_name.at(v_id) << ": " << graph.vertex_id_to_weight.at(v_id);
     }
 
     stream << std::endl << "edges:" << std::endl;
-    for (Vertex_Id v_id1 = 0; v_id1 < graph.numberOfNodes(); v_id1++) {
-        for (const Vertex_Id& v_id2 : graph.adjacencies[v_id1]) {
+    for (const Vertex_Id v_id1 : graph.vertices) {
+        for (const Vertex_Id v_id2 : graph.getNeighbours(v_id1)) {
             if (v_id1 > v_id2)
                 continue;
             stream << "(" << graph.vertex_id_to_name.at(v_id1) << "," << graph.vertex_id_to_name.at(v_id2) << ")" << std::endl;
@@ -24,6 +24,21 @@ std::vector<std::string> stringSplit(const std::string &str, char delim)
     return parts;
 }
 
+std::string_view firstContentLine(std::string_view text, char comment_prefix) {
+    while (!text.empty()) {
+        const size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty() && line[0] != comment_prefix)
+            return line;
+        if (end == std::string_view::npos)
+            break;
+        text.remove_prefix(end + 1);
+    }
+    return {};
+}
+
 bool endsWith(const std::string& str, const std::string& end) {
     if (end.size() > str.size())
         return false;
@@ -0,0 +1,186 @@
+#include "vertex_cover_reduction.h"
+
+#include <algorithm>
+#include <numeric>
+
+VertexCoverReduction::VertexCoverReduction(const UndirectedGraph& graph) : original_graph(graph) {
+    const std::vector<Vertex_Id>& vertices = graph.getVertices();
+    const size_t number_of_ids = vertices.empty() ? 0 : *std::max_element(vertices.begin(), vertices.end()) + 1;
+
+    std::vector<std::unordered_set<Vertex_Id>> neighbours(number_of_ids);
+    std::vector<Vertex_Cover_Weight> weights(number_of_ids, 0);
+    std::vector<bool> alive(number_of_ids, false);
+    // Folded vertices point to the vertex they were folded into.
+    std::vector<Vertex_Id> representative(number_of_ids);
+    std::iota(representative.begin(), representative.end(), 0);
+
+    for (const Vertex_Id v_id : vertices) {
+        alive[v_id] = true;
+        weights[v_id] = graph.getWeight(v_id);
+        for (const Vertex_Id u_id : graph.getNeighbours(v_id)) {
+            if (u_id != v_id)
+                neighbours[v_id].insert(u_id);
+        }
+    }
+
+    // Vertices whose neighbourhood changed since they were last looked at.
+    std::vector<Vertex_Id> worklist{vertices.rbegin(), vertices.rend()};
+
+    auto remove = [&neighbours, &alive, &worklist](Vertex_Id v_id) {
+        for (const Vertex_Id u_id : neighbours[v_id]) {
+            neighbours[u_id].erase(v_id);
+            worklist.push_back(u_id);
+        }
+        neighbours[v_id].clear();
+        alive[v_id] = false;
+    };
+    auto take = [this, &weights, &remove](Vertex_Id v_id) {
+        steps.push_back({Rule::Take, v_id});
+        weight_offset += weights[v_id];
+        remove(v_id);
+    };
+
+    while (!worklist.empty()) {
+        const Vertex_Id v_id = worklist.back();
+        worklist.pop_back();
+        if (!alive[v_id])
+            continue;
+
+        const std::unordered_set<Vertex_Id>& N = neighbours[v_id];
+        if (N.empty()) { // Rule I
+            alive[v_id] = false;
+            continue;
+        }
+
+        if (N.size() == 1) { // Rule II
+            const Vertex_Id u_id = *N.begin();
+            if (weights[u_id] <= weights[v_id]) {
+                take(u_id);
+            }
+            else {
+                steps.push_back({Rule::WeightShift, v_id, u_id});
+                weight_offset += weights[v_id];
+                weights[u_id] -= weights[v_id];
+                remove(v_id);
+            }
+            continue;
+        }
+
+        if (N.size() == 2) { // Rule III
+            const Vertex_Id a_id = *N.begin();
+            const Vertex_Id b_id = *std::next(N.begin());
+            if (!neighbours[a_id].contains(b_id)) {
+                if (weights[a_id] + weights[b_id] <= weights[v_id]) {
+                    take(a_id);
+                    take(b_id);
+                    continue;
+                }
+                if (std::max(weights[a_id], weights[b_id]) <= weights[v_id]) {
+                    steps.push_back({Rule::Fold, v_id, a_id, b_id});
+                    weight_offset += weights[v_id];
+                    weights[v_id] = weights[a_id] + weights[b_id] - weights[v_id];
+
+                    std::unordered_set<Vertex_Id> folded_neighbours;
+                    for (const Vertex_Id x_id : neighbours[a_id])
+                        folded_neighbours.insert(x_id);
+                    for (const Vertex_Id x_id : neighbours[b_id])
+                        folded_neighbours.insert(x_id);
+                    folded_neighbours.erase(v_id);
+
+                    remove(a_id);
+                    remove(b_id);
+                    for (const Vertex_Id x_id : folded_neighbours) {
+                        neighbours[v_id].insert(x_id);
+                        neighbours[x_id].insert(v_id);
+                    }
+                    representative[a_id] = v_id;
+                    representative[b_id] = v_id;
+                    worklist.push_back(v_id);
+                    continue;
+                }
+            }
+        }
+
+        // Rule IV
+        auto dominates = [&N, &neighbours, &weights, v_id](Vertex_Id u_id) {
+            if (weights[u_id] > weights[v_id] || neighbours[u_id].size() < N.size())
+                return false;
+            return std::all_of(N.begin(), N.end(), [&neighbours, u_id](Vertex_Id x_id) { return x_id == u_id || neighbours[u_id].contains(x_id); });
+        };
+        const auto dominating = std::find_if(N.begin(), N.end(), dominates);
+        if (dominating != N.end())
+            take(*dominating);
+    }
+
+    std::vector<Vertex_Id> kept_vertices;
+    std::vector<Edge> edges;
+    vertex_map.resize(number_of_ids);
+    for (const Vertex_Id v_id : vertices) {
+        if (alive[v_id]) {
+            kept_vertices.push_back(v_id);
+            for (const Vertex_Id u_id : neighbours[v_id]) {
+                if (v_id < u_id)
+                    edges.push_back({v_id, u_id});
+            }
+        }
+
+        Vertex_Id r_id = v_id;
+        while (representative[r_id] != r_id)
+            r_id = representative[r_id];
+        if (alive[r_id])
+            vertex_map[v_id] = r_id;
+    }
+
+    reduced_graph = graph.reducedGraph(kept_vertices, edges, weights);
+}
+
+const UndirectedGraph& VertexCoverReduction::getReducedGraph() const {
+    return reduced_graph;
+}
+
+/*
+Removing a vertex from all bags yields a tree decomposition of the remaining graph. Folding a and b into v contracts the edges {a, v} and {v, b}, so replacing a and b by v in all bags yields a tree decomposition of the folded graph.
+*/
+TreeDecomposition VertexCoverReduction::reduceTreeDecomposition(const TreeDecomposition& td) const {
+    return td.mapVertices(reduced_graph, vertex_map);
+}
+
+Solution VertexCoverReduction::lift(const Solution& reduced_solution) const {
+    std::vector<bool> in_cover(vertex_map.size(), false);
+    for (const Vertex_Id v_id : reduced_solution.past_vertex_cover)
+        in_cover[v_id] = true;
+
+    for (auto step = steps.rbegin(); step != steps.rend(); step++) {
+        switch (step->rule) {
+        case Rule::Take:
+            in_cover[step->v_id] = true;
+            break;
+        case Rule::WeightShift:
+            in_cover[step->v_id] = !in_cover[step->u_id];
+            break;
+        case Rule::Fold: {
+            // While v is folded, it is in the cover iff a and b are.
+            const bool folded_in_cover = in_cover[step->v_id];
+            in_cover[step->v_id] = !folded_in_cover;
+            in_cover[step->u_id] = folded_in_cover;
+            in_cover[step->w_id] = folded_in_cover;
+            break;
+        }
+        }
+    }
+
+    Solution solution{{}, reduced_solution.total_weight + weight_offset};
+    for (const Vertex_Id v_id : original_graph.getVertices()) {
+        if (in_cover[v_id])
+            solution.past_vertex_cover.insert(v_id);
+    }
+    return solution;
+}
+
+Vertex_Cover_Weight VertexCoverReduction::getWeightOffset() const {
+    return weight_offset;
+}
+
+size_t VertexCoverReduction::numberOfRemovedVertices() const {
+    return original_graph.numberOfNodes() - reduced_graph.numberOfNodes();
+}
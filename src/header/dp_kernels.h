@@ -0,0 +1,132 @@
+#pragma once
+
+#include "undirected_graph.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using Vertex_Cover_Weight = Vertex_Weight;
+
+// Subset of a bag: bit i is set iff the i-th vertex of the (sorted) bag is part of the subset.
+using Cover_Mask = size_t;
+
+// Table value of a subset of a bag that cannot be extended to a vertex cover.
+constexpr Vertex_Cover_Weight INVALID_COVER = std::numeric_limits<Vertex_Cover_Weight>::max();
+
+// One bit per subset of a bag, packed into 64-bit words.
+using Choice_Bits = std::vector<uint64_t>;
+
+template<typename Bits>
+bool getChoice(const Bits& choices, Cover_Mask U) {
+    return choices[U >> 6] >> (U & 63) & 1;
+}
+
+// Inserts bit `bit` at position `pos` of `mask`, shifting all higher bits up by one.
+inline Cover_Mask insertBit(Cover_Mask mask, size_t pos, Cover_Mask bit) {
+    const Cover_Mask low = mask & ((Cover_Mask{1} << pos) - 1);
+    return ((mask >> pos) << (pos + 1)) | (bit << pos) | low;
+}
+
+// Removes the bit at position `pos` of `mask`, shifting all higher bits down by one.
+inline Cover_Mask removeBit(Cover_Mask mask, size_t pos) {
+    const Cover_Mask low = mask & ((Cover_Mask{1} << pos) - 1);
+    return ((mask >> (pos + 1)) << pos) | low;
+}
+
+/*
+Kernels operating on whole dense DP tables. Every kernel comes in a scalar version and, on x86, in AVX2 and AVX-512 versions. The widest version supported by the CPU is picked at runtime.
+*/
+enum class SimdLevel {
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+// Returns the widest instruction set supported by the CPU that kernels are available for.
+SimdLevel detectSimdLevel();
+
+// Returns the instruction set the kernels currently dispatch to.
+SimdLevel getSimdLevel();
+
+// Makes the kernels dispatch to the given instruction set (e.g. for testing). Returns false (and changes nothing) if the CPU does not support it.
+bool setSimdLevel(SimdLevel level);
+
+std::string simdLevelName(SimdLevel level);
+
+// Fills `subset_weights` such that `subset_weights[U]` is the sum of `bag_weights[i]` over all bits i set in U.
+void computeSubsetWeights(const std::vector<Vertex_Cover_Weight>& bag_weights, std::vector<Vertex_Cover_Weight>& subset_weights);
+
+/*
+Splits the masks below `size` into blocks of consecutive masks that only differ in their lowest (at most) SUBSET_LOW_BITS bits and calls `f(start, block_size, low_weights, high_weight)` for each: The weight of the subset U of the bag in the block is low_weights[U - start] + high_weight.
+Unlike `computeSubsetWeights`, this needs no table of all 2^|bag| subset weights, which would be as large as a DP table.
+*/
+constexpr size_t SUBSET_LOW_BITS = 8;
+
+template<typename F>
+void forEachSubsetWeightBlock(const std::vector<Vertex_Cover_Weight>& bag_weights, size_t size, F&& f) {
+    const size_t low_bits = std::min(bag_weights.size(), SUBSET_LOW_BITS);
+    std::array<Vertex_Cover_Weight, size_t{1} << SUBSET_LOW_BITS> low_weights;
+    low_weights[0] = 0;
+    for (size_t i = 0; i < low_bits; i++) {
+        const size_t half = size_t{1} << i;
+        for (Cover_Mask U = 0; U < half; U++)
+            low_weights[half + U] = low_weights[U] + bag_weights[i];
+    }
+
+    const size_t block = size_t{1} << low_bits;
+    for (size_t start = 0; start < size; start += block) {
+        Vertex_Cover_Weight high_weight = 0;
+        for (size_t i = low_bits; i < bag_weights.size(); i++) {
+            if (start >> i & 1)
+                high_weight += bag_weights[i];
+        }
+        f(start, std::min(block, size - start), low_weights.data(), high_weight);
+    }
+}
+
+// Join of two tables over the bag with the vertex weights `bag_weights`: out[U] = left[U] + right[U] - (weight of U), or INVALID_COVER if either side is invalid.
+void joinKernel(const Vertex_Cover_Weight* left, const Vertex_Cover_Weight* right, const std::vector<Vertex_Cover_Weight>& bag_weights, Vertex_Cover_Weight* out, size_t size);
+
+/*
+Introduce of the vertex at bit position `pos` of the parent's bag. `child` has `child_size` entries, `out` twice as many.
+`neighbour_mask` holds the introduced vertex's neighbours in the child's bag: If the vertex is not in the cover, all of them have to be.
+*/
+void introduceKernel(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Cover_Weight v_weight);
+
+/*
+Forget of the vertex at bit position `pos` of the child's bag: out[U] is the minimum of the two child entries U with and without that vertex. `out` has `out_size` entries, `child` twice as many.
+The bit of U in `choices` (which has to be zeroed and hold at least `out_size` bits) is set iff the entry with the vertex is strictly better.
+*/
+void forgetKernel(const Vertex_Cover_Weight* child, Vertex_Cover_Weight* out, uint64_t* choices, size_t out_size, size_t pos);
+
+/*
+Maps masks over a bag to masks over a subset of the bag's positions: Bit j of the result is bit `positions[j]` of the input (like the BMI2 instruction pext). Uses one lookup table for the lower and one for the upper half of the input bits.
+*/
+class BitProjection {
+    size_t low_bits;
+    std::vector<Cover_Mask> low;
+    std::vector<Cover_Mask> high;
+
+public:
+    BitProjection(size_t num_bits, const std::vector<size_t>& positions);
+
+    Cover_Mask operator()(Cover_Mask mask) const {
+        return low[mask & ((Cover_Mask{1} << low_bits) - 1)] | high[mask >> low_bits];
+    }
+};
+
+/*
+Forgets any number of vertices at once in a single pass over the child table: acc[to_common(U')] is the minimum of child[U'] over all U' with the same common part. `acc` has to be filled with INVALID_COVER beforehand.
+`choices[key]` is set to `to_forgotten(U')` of the minimizing entry U'.
+*/
+void forgetManyKernel(const Vertex_Cover_Weight* child, size_t child_size, const BitProjection& to_common, const BitProjection& to_forgotten, Vertex_Cover_Weight* acc, uint32_t* choices);
+
+/*
+Introduces any number of vertices at once in a single pass over the parent table: out[U] is acc[to_common(U)] plus the weight of the introduced vertices in U, or INVALID_COVER if an introduced vertex is missing from U while one of its neighbours in the parent's bag is missing too.
+`introduced_weights[to_introduced(U)]` is the weight of the introduced vertices in U. `introduced_neighbour_masks[i]` are the neighbours of the i-th introduced vertex in the parent's bag.
+*/
+void introduceManyKernel(const Vertex_Cover_Weight* acc, Vertex_Cover_Weight* out, size_t out_size, const BitProjection& to_common, const BitProjection& to_introduced, const Vertex_Cover_Weight* introduced_weights, const std::vector<Cover_Mask>& introduced_neighbour_masks);
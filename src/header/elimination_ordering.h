@@ -0,0 +1,22 @@
+#pragma once
+
+#include "undirected_graph.h"
+
+#include <string>
+#include <vector>
+
+/*
+Greedy heuristics for elimination orderings. Eliminating a vertex turns its remaining neighbours into a clique (the "fill-in") and removes it. Every elimination ordering yields a tree decomposition whose bags are the eliminated vertices together with their neighbours at the time of their elimination (see `TreeDecomposition::fromEliminationOrdering`).
+*/
+enum class EliminationHeuristic {
+    // Eliminates a vertex of minimum degree next.
+    MinDegree,
+    // Eliminates a vertex whose elimination adds the fewest fill edges next, ties are broken by minimum degree.
+    MinFill
+};
+
+// Parses "min-degree" or "min-fill". Throws std::invalid_argument otherwise.
+EliminationHeuristic parseEliminationHeuristic(const std::string& name);
+
+// Returns all vertices of `graph` in the order they are eliminated by `heuristic`.
+std::vector<Vertex_Id> computeEliminationOrdering(const UndirectedGraph& graph, EliminationHeuristic heuristic);
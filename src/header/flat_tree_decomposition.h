@@ -0,0 +1,65 @@
+#pragma once
+
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+
+#include <span>
+#include <vector>
+
+/*
+Frozen copy of a rooted tree decomposition for solving. All arrays are indexed by the ids of the original nodes (or, for `nice`, of the new ones): The children of every node are stored in compressed sparse rows and its bag as a sorted range of one pool of vertex ids. Names are not stored, they stay with the `TreeDecomposition`.
+Unlike `Node`, which holds three hash sets and a string, a node costs a few words plus its bag, and traversals run over contiguous arrays.
+*/
+class FlatTreeDecomposition {
+public:
+    // Throws std::invalid_argument if `td` is not rooted.
+    explicit FlatTreeDecomposition(const TreeDecomposition& td);
+
+    /*
+    Returns the nice tree decomposition that `td.turnIntoNiceTreeDecomposition(join_tree_shape)` creates, without changing `td` and in time linear in the size of the result (after sorting the bags of `td` once). Each node is built from the bag of its parent by removing or adding a single vertex, and a node whose bag equals its single parent's is merged into the parent right away instead of removed afterwards.
+    The nodes get new ids from 0 (the root) on. Throws std::invalid_argument if `td` is not rooted.
+    */
+    static FlatTreeDecomposition nice(const TreeDecomposition& td, JoinTreeShape join_tree_shape = JoinTreeShape::Caterpillar);
+
+    Node_Id getRoot() const;
+
+    size_t numberOfNodes() const;
+
+    // All node ids are smaller than this bound.
+    size_t idBound() const;
+
+    // Returns all nodes in pre-order, thus every node comes after its parent.
+    const std::vector<Node_Id>& getPreOrder() const;
+
+    // Returns the bag of `n_id` sorted by vertex id.
+    std::span<const Vertex_Id> getBag(Node_Id n_id) const;
+
+    std::span<const Node_Id> getChildren(Node_Id n_id) const;
+
+    std::optional<Node_Id> getParent(Node_Id n_id) const;
+
+    size_t getTreewidth() const;
+
+    // Whether every node is a leaf, introduce, forget or join node (see `TreeDecomposition::nodeType`).
+    bool isNice() const;
+
+    friend class Snapshot;
+
+private:
+    static constexpr Node_Id NO_NODE = SIZE_MAX;
+
+    FlatTreeDecomposition() = default;
+
+    // Fills `child_offsets`, `children` and `pre_order` from `parents`.
+    void linkChildren();
+
+    Node_Id root;
+    std::vector<Node_Id> pre_order;
+    std::vector<Node_Id> parents;
+
+    // The children of n are children[child_offsets[n]] up to children[child_offsets[n + 1]], likewise for the bags.
+    std::vector<size_t> child_offsets;
+    std::vector<Node_Id> children;
+    std::vector<size_t> bag_offsets;
+    std::vector<Vertex_Id> bags;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/*
+Read-only memory mapping of a whole file, so that parsers can scan it in place instead of copying it line by line.
+*/
+class MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+
+public:
+    // Throws std::invalid_argument if the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    std::string_view contents() const { return {data, size}; }
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "util.h"
+#include "undirected_graph.h"
+#include "dp_kernels.h"
+#include "tree_decomposition_dp.h"
+
+#include <limits>
+
+using Independent_Set_Weight = Vertex_Weight;
+
+// Table value of a subset of a bag that is not independent.
+constexpr Independent_Set_Weight INVALID_SET = std::numeric_limits<Independent_Set_Weight>::min();
+
+struct IndependentSetSolution {
+    Vertex_Set independent_set;
+    Independent_Set_Weight total_weight;
+};
+
+std::ostream& operator<<(std::ostream& os, const IndependentSetSolution& sol);
+
+/*
+MAXIMUM WEIGHTED INDEPENDENT SET: A vertex is in state 1 iff it is part of the independent set.
+An entry holds the maximum weight of an independent set of the subtree's graph whose intersection with the bag is exactly the entry's subset (or `INVALID_SET`).
+*/
+struct IndependentSetProblem {
+    using Value = Independent_Set_Weight;
+    using Solution = IndependentSetSolution;
+
+    static constexpr size_t STATES = 2;
+    static constexpr bool HAS_WITNESS = true;
+    static constexpr bool FUSED_TRANSITIONS = false;
+
+    static Value emptyBag() { return 0; }
+
+    static void introduce(const Value* child, Value* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Weight v_weight);
+
+    // The bit of an entry in `choices` is set iff the entry with the forgotten vertex is strictly better.
+    static void forget(const Value* child, Value* out, uint64_t* choices, size_t out_size, size_t pos);
+
+    static void join(const Value* left, const Value* right, Value* out, size_t size, const std::vector<Vertex_Weight>& bag_weights);
+
+    // The maximum root entry.
+    static Value aggregate(const Value* root, size_t size, size_t& best);
+
+    static Solution makeSolution(Vertex_Set&& independent_set, Value weight) { return Solution{std::move(independent_set), weight}; }
+};
+
+extern template class TreeDecompositionDP<IndependentSetProblem>;
+
+using MaxWeightedIndependentSet = TreeDecompositionDP<IndependentSetProblem>;
@@ -3,9 +3,10 @@
 #include "util.h"
 #include "undirected_graph.h"
 #include "tree_decomposition.h"
+#include "dp_kernels.h"
+#include "tree_decomposition_dp.h"
 
-using Vertex_Cover = std::unordered_set<Vertex_Id>;
-using Vertex_Cover_Weight = Vertex_Weight;
+using Vertex_Cover = Vertex_Set;
 
 struct Solution {
     Vertex_Cover past_vertex_cover;
@@ -16,23 +17,36 @@ std::ostream& operator<<(std::ostream& os, const Solution& sol);
 
 bool operator<(const Solution& sol1, const Solution& sol2);
 
-using Table = std::unordered_map<Vertex_Cover, Solution>;
+/*
+MINIMUM WEIGHTED VERTEX COVER: A vertex is in state 1 iff it is part of the cover, so an entry's index is the `Cover_Mask` of the cover's intersection with the bag.
+An entry holds the minimum weight of a vertex cover of the subtree's graph with exactly that intersection (or `INVALID_COVER`). The kernels are the SIMD kernels of dp_kernels.h.
+*/
+struct VertexCoverProblem {
+    using Value = Vertex_Cover_Weight;
+    using Solution = ::Solution;
 
-class MinWeightedVertexCover {
+    static constexpr size_t STATES = 2;
+    static constexpr bool HAS_WITNESS = true;
+    static constexpr bool FUSED_TRANSITIONS = true;
 
-public:
+    static Value emptyBag() { return 0; }
 
-    MinWeightedVertexCover(const UndirectedGraph& graph_, const TreeDecomposition& td_) : graph(graph_), td(td_) {}
+    static void introduce(const Value* child, Value* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Weight v_weight);
 
-    Solution solve();
+    static void forget(const Value* child, Value* out, uint64_t* choices, size_t out_size, size_t pos);
 
-    std::unordered_map<Node_Id, Table>M;
+    static void join(const Value* left, const Value* right, Value* out, size_t size, const std::vector<Vertex_Weight>& bag_weights);
 
-private:
-    const UndirectedGraph& graph;
-    const TreeDecomposition& td;
+    static void forgetMany(const Value* child, size_t child_size, const BitProjection& to_common, const BitProjection& to_forgotten, Value* out, size_t out_size, uint32_t* choices);
 
-    std::unordered_set<Vertex_Cover> intersect(Node_Id n1_id, Node_Id n2_id) const;
+    static void introduceMany(const Value* child, Value* out, size_t out_size, const BitProjection& to_common, const BitProjection& to_introduced, const std::vector<Vertex_Weight>& introduced_weights, const std::vector<Cover_Mask>& introduced_neighbour_masks);
 
-    Solution addToSolution(const Solution& sol, Vertex_Id v_id) const;
-};
\ No newline at end of file
+    // The minimum root entry.
+    static Value aggregate(const Value* root, size_t size, size_t& best);
+
+    static Solution makeSolution(Vertex_Set&& cover, Value weight) { return Solution{std::move(cover), weight}; }
+};
+
+extern template class TreeDecompositionDP<VertexCoverProblem>;
+
+using MinWeightedVertexCover = TreeDecompositionDP<VertexCoverProblem>;
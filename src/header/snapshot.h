@@ -0,0 +1,71 @@
+#pragma once
+
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "flat_tree_decomposition.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+/*
+Versioned binary snapshot of a graph together with its rooted (usually nice) tree decomposition in flat form, so that repeated runs on the same instance skip parsing, rooting and the nice conversion.
+All numbers are stored in the byte order of the machine that wrote the file. After a fixed header, the file consists of these sections, each padded to a multiple of 8 bytes:
+    graph ... vertices, the weight, CSR adjacency (offsets and neighbours sorted by id) and name (offsets and characters) of every vertex id, and the edges as pairs of ids,
+    tree decomposition ... the parent of every node (NO_NODE for the root) and the bags (offsets and sorted vertex ids). The nodes are numbered in pre-order, thus the root is node 0 and every other node comes after its parent.
+The file is mapped and the graph's CSR and the flat tree decomposition are copied from its sections as they are.
+*/
+class Snapshot {
+public:
+    static constexpr uint32_t VERSION = 3;
+
+    // Writes `graph` and `td`, which has to be a tree decomposition of `graph`, to `path`. Throws std::runtime_error if writing fails.
+    static void save(const std::string& path, const UndirectedGraph& graph, const FlatTreeDecomposition& td);
+
+    // Maps the snapshot at `path`. Throws std::invalid_argument if it is not a snapshot of this version, is truncated or refers to vertices or nodes it does not contain.
+    explicit Snapshot(const std::string& path);
+
+    UndirectedGraph graph() const;
+
+    FlatTreeDecomposition flatTreeDecomposition() const;
+
+    // Returns the tree decomposition as a `TreeDecomposition` of `graph`, which has to be the graph returned by `graph()`, so that it can still be made nice. The nodes are named by their number.
+    TreeDecomposition treeDecomposition(const UndirectedGraph& graph) const;
+
+    // Whether the tree decomposition was nice when it was saved.
+    bool isNice() const;
+
+private:
+    static constexpr uint64_t NO_NODE = UINT64_MAX;
+
+    static constexpr uint32_t NICE = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t number_of_ids;
+        uint64_t number_of_vertices;
+        uint64_t number_of_adjacencies;
+        uint64_t number_of_edges;
+        uint64_t names_bytes;
+        uint64_t number_of_nodes;
+        uint64_t number_of_bag_entries;
+    };
+
+    MappedFile file;
+    Header header;
+
+    std::span<const uint64_t> vertices;
+    std::span<const int32_t> weights;
+    std::span<const uint64_t> adjacency_offsets;
+    std::span<const uint64_t> adjacencies;
+    std::span<const uint64_t> name_offsets;
+    std::span<const char> names;
+    std::span<const uint64_t> edges;
+
+    std::span<const uint64_t> parents;
+    std::span<const uint64_t> bag_offsets;
+    std::span<const uint64_t> bags;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+// Where and from which size on buffers are backed by memory-mapped files instead of the heap.
+struct SpillOptions {
+    size_t threshold_bytes = SIZE_MAX;
+    std::string directory = defaultSpillDirectory();
+
+    // Whether buffers that stay in memory and span at least one huge page are backed by transparent huge pages.
+    bool use_huge_pages = false;
+
+    // $TMPDIR if set, /tmp otherwise.
+    static std::string defaultSpillDirectory();
+};
+
+// Maps a new, already unlinked temporary file of `bytes` bytes in `directory`. The file is zero-filled and read sequentially by the OS. Throws std::runtime_error on failure.
+void* mapTemporaryFile(size_t bytes, const std::string& directory);
+
+void unmapTemporaryFile(void* ptr, size_t bytes);
+
+constexpr size_t HUGE_PAGE_BYTES = size_t{2} << 20;
+
+// Maps `bytes` bytes of anonymous memory advised to be backed by transparent huge pages. Throws std::runtime_error on failure.
+void* mapHugePages(size_t bytes);
+
+void unmapHugePages(void* ptr, size_t bytes);
+
+/*
+Fixed-size array that lives on the heap or, if it is at least `SpillOptions::threshold_bytes` large, in a memory-mapped temporary file. Backing large buffers by files lets the OS page them out to disk instead of running out of memory, as long as they are accessed (mostly) sequentially.
+Large in-memory buffers can be backed by huge pages instead of the heap (see `SpillOptions::use_huge_pages`).
+*/
+template<typename T>
+class SpillableBuffer {
+public:
+    enum class Backing { Heap, File, HugePages };
+
+    // The backing `allocate(size, options)` chooses.
+    static Backing backingFor(size_t size, const SpillOptions& options) {
+        const size_t bytes = size * sizeof(T);
+        if (bytes >= options.threshold_bytes && size > 0)
+            return Backing::File;
+        if (options.use_huge_pages && bytes >= HUGE_PAGE_BYTES)
+            return Backing::HugePages;
+        return Backing::Heap;
+    }
+
+private:
+    T* ptr = nullptr;
+    size_t count = 0;
+    Backing backing = Backing::Heap;
+
+public:
+    SpillableBuffer() = default;
+
+    SpillableBuffer(const SpillableBuffer&) = delete;
+    SpillableBuffer& operator=(const SpillableBuffer&) = delete;
+
+    SpillableBuffer(SpillableBuffer&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    SpillableBuffer& operator=(SpillableBuffer&& other) noexcept {
+        std::swap(ptr, other.ptr);
+        std::swap(count, other.count);
+        std::swap(backing, other.backing);
+        return *this;
+    }
+
+    ~SpillableBuffer() {
+        release();
+    }
+
+    // Replaces the contents by `size` uninitialized elements (zero-initialized if the buffer is spilled).
+    void allocate(size_t size, const SpillOptions& options) {
+        release();
+        const size_t bytes = size * sizeof(T);
+        const Backing new_backing = backingFor(size, options);
+        if (new_backing == Backing::File)
+            ptr = static_cast<T*>(mapTemporaryFile(bytes, options.directory));
+        else if (new_backing == Backing::HugePages)
+            ptr = static_cast<T*>(mapHugePages(bytes));
+        else
+            ptr = new T[size];
+        count = size;
+        backing = new_backing;
+    }
+
+    void release() {
+        if (backing == Backing::File)
+            unmapTemporaryFile(ptr, count * sizeof(T));
+        else if (backing == Backing::HugePages)
+            unmapHugePages(ptr, count * sizeof(T));
+        else
+            delete[] ptr;
+        ptr = nullptr;
+        count = 0;
+        backing = Backing::Heap;
+    }
+
+    bool isSpilled() const { return backing == Backing::File; }
+
+    Backing getBacking() const { return backing; }
+
+    size_t size() const { return count; }
+
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+
+    T* begin() { return ptr; }
+    T* end() { return ptr + count; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + count; }
+
+    T& operator[](size_t i) { return ptr[i]; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "dp_kernels.h"
+#include "spillable_buffer.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/*
+Pool of DP table buffers with entries of type `T`, grouped by their exact number of entries. Buffers of tables that have been consumed by their parent are handed back to the pool and handed out again for the next table of the same size and backing, so that a solve only allocates memory for as many tables as are live at the same time.
+*/
+template<typename T>
+class TableArena {
+public:
+    // At most `max_free_per_size` unused buffers are kept per number of entries, further ones are freed.
+    explicit TableArena(size_t max_free_per_size = 4) : max_free_per_size(max_free_per_size) {}
+
+    // Returns a buffer with `size` entries of unspecified content, backed as `options` asks for.
+    SpillableBuffer<T> acquire(size_t size, const SpillOptions& options);
+
+    // Hands a buffer that is no longer needed back to the pool.
+    void recycle(SpillableBuffer<T>&& buffer);
+
+    // Frees all unused buffers.
+    void clear();
+
+    size_t numberOfAcquiredBuffers() const;
+
+    size_t numberOfReusedBuffers() const;
+
+private:
+    size_t max_free_per_size;
+
+    mutable std::mutex mutex;
+    std::unordered_map<size_t, std::vector<SpillableBuffer<T>>> free_buffers;
+
+    size_t acquired_buffers = 0;
+    size_t reused_buffers = 0;
+};
+
+extern template class TableArena<Vertex_Cover_Weight>;
+extern template class TableArena<uint64_t>;
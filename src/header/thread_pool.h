@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Task = std::function<void()>;
+
+/*
+Thread pool in which every worker owns a deque of tasks. A worker takes tasks from the back of its own deque (most recently submitted first, which keeps it working within the same subtree) and, once that runs dry, steals from the front of the other workers' deques.
+Tasks submitted from within a task land in the submitting worker's deque, tasks submitted from outside of the pool are distributed round-robin.
+*/
+class WorkStealingThreadPool {
+public:
+    explicit WorkStealingThreadPool(size_t num_threads);
+
+    ~WorkStealingThreadPool();
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    void submit(Task task);
+
+    // Blocks until every submitted task (including tasks submitted by tasks) has finished. If a task threw, the tasks still queued are dropped and the first exception is rethrown here, after which the pool can be used again.
+    void wait();
+
+    size_t numberOfThreads() const;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex idle_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+
+    std::atomic<size_t> queued_tasks = 0;
+    std::atomic<size_t> unfinished_tasks = 0;
+    std::atomic<size_t> next_queue = 0;
+    bool stopping = false;
+
+    // The first exception thrown by a task, guarded by `idle_mutex`. While `failed` is set, workers drop tasks instead of running them.
+    std::exception_ptr exception;
+    std::atomic<bool> failed = false;
+
+    void workerLoop(size_t worker_index);
+
+    bool popLocal(size_t worker_index, Task& task);
+
+    bool steal(size_t worker_index, Task& task);
+};
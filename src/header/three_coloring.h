@@ -0,0 +1,40 @@
+#pragma once
+
+#include "util.h"
+#include "undirected_graph.h"
+#include "dp_kernels.h"
+#include "tree_decomposition_dp.h"
+
+#include <cstdint>
+
+// Number of colorings, modulo 2^64.
+using Coloring_Count = uint64_t;
+
+/*
+Counting 3-COLORINGS: The state of a vertex is its color. An entry holds the number of proper colorings of the subtree's graph that color the bag as given by the entry's index (in base 3).
+*/
+struct ThreeColoringProblem {
+    using Value = Coloring_Count;
+    using Solution = Coloring_Count;
+
+    static constexpr size_t STATES = 3;
+    static constexpr bool HAS_WITNESS = false;
+    static constexpr bool FUSED_TRANSITIONS = false;
+
+    static Value emptyBag() { return 1; }
+
+    static void introduce(const Value* child, Value* out, size_t child_size, size_t pos, Cover_Mask neighbour_mask, Vertex_Weight v_weight);
+
+    static void forget(const Value* child, Value* out, uint64_t* choices, size_t out_size, size_t pos);
+
+    static void join(const Value* left, const Value* right, Value* out, size_t size, const std::vector<Vertex_Weight>& bag_weights);
+
+    // The number of all colorings.
+    static Value aggregate(const Value* root, size_t size, size_t& best);
+
+    static Solution makeSolution(Vertex_Set&&, Value count) { return count; }
+};
+
+extern template class TreeDecompositionDP<ThreeColoringProblem>;
+
+using ThreeColoringCounter = TreeDecompositionDP<ThreeColoringProblem>;
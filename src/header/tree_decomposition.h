@@ -2,9 +2,13 @@
 
 #include "undirected_graph.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <iostream>
 #include <unordered_set>
 #include <functional>
+#include <memory>
 #include <optional>
 
 using Node_Id = size_t;
@@ -32,6 +36,70 @@ public:
     std::unordered_set<Node_Id> children;
 };
 
+// How to pick the root in `TreeDecomposition::rootTree`.
+enum class RootSelection {
+    // Any node with the largest bag.
+    LargestBag,
+    // The node minimizing the estimated cost of solving on the nice tree decomposition rooted there (see `RootingCostModel`).
+    MinimumCost
+};
+
+// The role of a node in a nice tree decomposition (see `TreeDecomposition::nodeType`).
+enum class NiceNodeType : uint8_t {
+    Leaf,
+    Introduce,
+    Forget,
+    Join,
+    // A node that cannot be part of a nice tree decomposition.
+    Other
+};
+
+// How `TreeDecomposition::makeNJoinNodeNice` arranges the join nodes above c children. Every shape adds 2(c - 1) nodes with the bag of the parent.
+enum class JoinTreeShape {
+    // A chain of depth c that takes one more child at every join.
+    Caterpillar,
+    // A complete binary tree of depth ceil(log2 c).
+    Balanced,
+    // Joins the two cheapest subtrees first, as in Huffman coding, so that expensive subtrees are joined close to the parent.
+    Weighted
+};
+
+/*
+Hangs the subtrees `leaves`, given by their cost and root, below a binary tree of join nodes by repeatedly calling `join(n_id1, n_id2, is_last_join)`, which returns the root of the joined subtree. Like Huffman coding, this keeps the leaves sorted by cost and the joined subtrees in a second queue, whose costs never decrease, and takes the cheaper front.
+Without weights all costs are 0: If ties go to the leaves, all leaves are paired before their pairs are, which yields a balanced tree. If ties go to the joined subtrees, the last one is always joined with the next leaf, which yields a caterpillar.
+*/
+template<typename Join>
+void buildJoinTree(std::deque<std::pair<double, Node_Id>> leaves, JoinTreeShape join_tree_shape, Join&& join) {
+    std::stable_sort(leaves.begin(), leaves.end(), [](const auto& leaf1, const auto& leaf2) { return leaf1.first < leaf2.first; });
+
+    std::deque<std::pair<double, Node_Id>> joined;
+    auto takeCheapest = [&leaves, &joined, join_tree_shape]() {
+        const bool take_leaf = joined.empty() || (!leaves.empty() && (join_tree_shape == JoinTreeShape::Caterpillar
+            ? leaves.front().first < joined.front().first
+            : leaves.front().first <= joined.front().first));
+        std::deque<std::pair<double, Node_Id>>& queue = take_leaf ? leaves : joined;
+        const std::pair<double, Node_Id> cheapest = queue.front();
+        queue.pop_front();
+        return cheapest;
+    };
+
+    while (leaves.size() + joined.size() >= 2) {
+        const auto [cost1, n_id1] = takeCheapest();
+        const auto [cost2, n_id2] = takeCheapest();
+        const bool is_last_join = leaves.empty() && joined.empty();
+        joined.push_back({cost1 + cost2, join(n_id1, n_id2, is_last_join)});
+    }
+}
+
+/*
+Estimates the cost of solving on the nice tree decomposition that `turnIntoNiceTreeDecomposition` creates for a given root, with STATES^|bag| entries per table: The entries of all its nodes, the entries of its join nodes once more times `join_weight`, and the peak number of live entries (as in a memory-aware post-order over the original nodes) times `peak_weight`.
+*/
+struct RootingCostModel {
+    size_t states = 2;
+    double join_weight = 1.0;
+    double peak_weight = 1.0;
+};
+
 class TreeDecomposition {
     std::unordered_map<Node_Id, Node> nodes;
     std::unordered_map<std::string, Node_Id> node_name_to_id;
@@ -46,11 +114,24 @@ class TreeDecomposition {
 
     // To make it a nice tree decomposition:
     size_t new_nodes_counter=0;
+
+    // Depth-first orders of the rooted tree.
+    struct Schedule {
+        std::vector<Node_Id> pre_order;
+        std::vector<Node_Id> post_order;
+    };
+
+    // Computed by the first traversal after the tree changed (and right after rooting and the nice conversion, so that later traversals only read it). Traversals hold on to the schedule they started with.
+    mutable std::shared_ptr<const Schedule> cached_schedule;
     
 public:
 
+    // Parses a tree decomposition of `graph` in the CSV format or, if the file ends with .td or starts with an "s td" line, in the PACE 2017 format.
     static TreeDecomposition parseUnsafe(const std::string& input_path, const UndirectedGraph& graph);
 
+    // Returns the (unrooted) tree decomposition of `graph` induced by eliminating its vertices in the order `ordering`: The bag of a vertex holds it and its neighbours at the time of its elimination and is attached to the bag of the first of these neighbours to be eliminated. A bag contained in the bag of one of its children is merged into that child. The width equals the largest such neighbourhood.
+    static TreeDecomposition fromEliminationOrdering(const UndirectedGraph& graph, const std::vector<Vertex_Id>& ordering);
+
     // Returns true if it is a valid tree decomposition
     bool isValid() const;
 
@@ -70,17 +151,29 @@ public:
     // Returns the children and parents of each node in the tree decomposition if the root were `designated_root`.
     void rootTree(Node_Id designated_root);
 
+    // Roots the tree decomposition at the node chosen by `selection`. Returns the root node.
+    Node_Id rootTree(RootSelection selection, const RootingCostModel& model = {});
+
+    // Returns the estimated cost of every node as the root. Takes time linear in the total size of all bags, the tree decomposition does not need to be rooted.
+    std::unordered_map<Node_Id, double> estimateRootCosts(const RootingCostModel& model) const;
+
     // Removes the single child of nodes whose bag is identical to its childs' and instead connects the parent to all its child's children.
     void removeDuplicateNeighbours();
 
     const Node& getNode(Node_Id n_id) const;
 
+    // Returns a copy of this tree decomposition for `graph`, in which every vertex v of a bag is replaced by `vertex_map[v]` or removed if that is empty. The result is a tree decomposition of `graph` if `graph` arises from this decomposition's graph by deleting vertices and contracting edges accordingly.
+    TreeDecomposition mapVertices(const UndirectedGraph& graph, const std::vector<std::optional<Vertex_Id>>& vertex_map) const;
+
     //// To make it a nice tree decomposition ////
 
     bool isNiceTreeDecomposition() const;
 
-    // Turns this tree decomposition into a nice tree decomposition.
-    void turnIntoNiceTreeDecomposition();
+    // Classifies the node by its children in the rooted tree decomposition.
+    NiceNodeType nodeType(Node_Id n_id) const;
+
+    // Turns this tree decomposition into a nice tree decomposition, joining the children of every node as a tree of shape `join_tree_shape`.
+    void turnIntoNiceTreeDecomposition(JoinTreeShape join_tree_shape = JoinTreeShape::Caterpillar);
 
     size_t getTreewidth() const;
 
@@ -88,25 +181,32 @@ public:
     void bridgeDifference(Node_Id parent_id);
 
     // Given the id of a node with more than one child, fills the space between it and its children such that every node in between is either a join node or an introduce node or a forget node.
-    void makeNJoinNodeNice(Node_Id parent_id);
+    // For `JoinTreeShape::Weighted`, `subtree_costs` holds the cost of the subtree below each child. Children missing from it cost 2^|bag|.
+    void makeNJoinNodeNice(Node_Id parent_id, JoinTreeShape join_tree_shape = JoinTreeShape::Caterpillar, const std::unordered_map<Node_Id, double>& subtree_costs = {});
 
     std::vector<std::string> getAllNodeNames() const;
 
-    void doSomethingPreOrder(std::function<void(Node_Id)>f) const;
-    
-    void doSomethingPreOrder(std::function<void(Node_Id)>f, Node_Id n_id) const;
-
-    void doSomethingPostOrder(std::function<void(Node_Id)>f) const;
-    
-    void doSomethingPostOrder(std::function<void(Node_Id)>f, Node_Id n_id) const;
-
-    void doWhilePreOrder(std::function<void(Node_Id)>f, std::function<bool()>pred) const;
+    // Calls `f` with every node of the rooted tree, each before its children. `f` may change the tree, the nodes visited are those of the tree when the traversal started.
+    template<typename F>
+    void doSomethingPreOrder(F&& f) const {
+        const std::shared_ptr<const Schedule> held_schedule = schedule();
+        for (const Node_Id n_id : held_schedule->pre_order)
+            f(n_id);
+    }
 
-    void doWhilePreOrder(std::function<void(Node_Id)>f, std::function<bool()>pred, Node_Id n_id) const;
+    // Like `doSomethingPreOrder`, but each node after its children.
+    template<typename F>
+    void doSomethingPostOrder(F&& f) const {
+        const std::shared_ptr<const Schedule> held_schedule = schedule();
+        for (const Node_Id n_id : held_schedule->post_order)
+            f(n_id);
+    }
 
     friend
     std::ostream& operator<<(std::ostream& stream, const TreeDecomposition& td);
 
+    friend class Snapshot;
+
 private:
 
     TreeDecomposition(const UndirectedGraph& graph) : graph_ptr(&graph) {}
@@ -119,9 +219,21 @@ private:
 
     Node_Id addNode(std::string n_name);
 
+    // Like `addNode(n_name)`, but names that are small integers are looked up in `numeric_name_to_id` instead of by hashing.
+    Node_Id addNode(std::string_view n_name, std::vector<std::optional<Node_Id>>& numeric_name_to_id);
+
+    void parseCsv(std::string_view contents);
+
+    void parsePace(std::string_view contents);
+
     void removeNode(Node_Id n_id);
     
     void addEdge(Node_Id n1_id, Node_Id n2_id);
 
     void removeEdge(Node_Id n1_id, Node_Id n2_id);
+
+    // Returns the schedule of the rooted tree, computing it if the tree changed since.
+    std::shared_ptr<const Schedule> schedule() const;
+
+    void invalidateSchedule();
 };
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "util.h"
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "flat_tree_decomposition.h"
+#include "dp_kernels.h"
+#include "spillable_buffer.h"
+#include "table_arena.h"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <mutex>
+
+using Vertex_Set = std::unordered_set<Vertex_Id>;
+
+/*
+A problem the DP engine can solve is a policy type with static members only. Every vertex of a bag is in one of `STATES` states and a node's table holds one `Value` per assignment of states to the vertices of its (sorted) bag: The state of the i-th vertex is the i-th digit of the entry's index in base `STATES`.
+The kernels work on whole tables, thus the recurrences of a problem are compiled into its own kernels and the engine only dispatches once per node.
+*/
+template<typename P>
+concept DPProblem = requires(const typename P::Value* in, typename P::Value* out, uint64_t* choices, size_t size, size_t pos, Cover_Mask neighbour_mask, Vertex_Weight weight, const std::vector<Vertex_Weight>& bag_weights, size_t& best, Vertex_Set&& selected) {
+    typename P::Value;
+    typename P::Solution;
+    { P::STATES } -> std::convertible_to<size_t>;
+    // Whether the states of the best root entry are traced back to all vertices. Requires STATES == 2, the vertices in state 1 are passed to makeSolution.
+    { P::HAS_WITNESS } -> std::convertible_to<bool>;
+    // Whether forgetMany and introduceMany are available, so that bags of adjacent nodes may differ in more than one vertex. Requires STATES == 2.
+    { P::FUSED_TRANSITIONS } -> std::convertible_to<bool>;
+    // The single entry of the table of an empty bag.
+    { P::emptyBag() } -> std::same_as<typename P::Value>;
+    // Introduce of the vertex at position `pos` of the parent's bag, `neighbour_mask` holds its neighbours in the child's bag. `out` has STATES * `size` entries.
+    P::introduce(in, out, size, pos, neighbour_mask, weight);
+    // Forget of the vertex at position `pos` of the child's bag. `out` has `size` entries. If HAS_WITNESS, the bit of every entry in (zeroed) `choices` is set iff the forgotten vertex is in state 1 for its best child entry.
+    P::forget(in, out, choices, size, pos);
+    // Join of two tables over the same bag, `out` may be `left`.
+    P::join(in, in, out, size, bag_weights);
+    // Returns the value of the problem given the root table and sets `best` to the root entry to trace back.
+    { P::aggregate(in, size, best) } -> std::same_as<typename P::Value>;
+    { P::makeSolution(std::move(selected), in[0]) } -> std::same_as<typename P::Solution>;
+};
+
+template<size_t STATES>
+constexpr size_t tableSize(size_t bag_size) {
+    size_t size = 1;
+    for (size_t i = 0; i < bag_size; i++)
+        size *= STATES;
+    return size;
+}
+
+// Resources `TreeDecompositionDP::solve` is predicted to need on a tree decomposition.
+struct SolveEstimate {
+    // Entries of all tables, including the intermediate tables of leaves, transitions and joins.
+    double total_entries = 0;
+    // Entries read and written by all kernels, the unit of `TreeDecompositionDP::setProgressCallback`.
+    double work = 0;
+    // Peak number of live table entries of the sequential schedule or, on several threads, an upper bound of it.
+    double peak_entries = 0;
+    // Memory of these entries plus the choices kept for reconstructing the solution.
+    double peak_bytes = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, const SolveEstimate& estimate);
+
+/*
+Dense DP table of a single node. The vertices of the node's bag are sorted by id and the state of `bag[i]` is the i-th digit of an entry's index.
+*/
+template<DPProblem Problem>
+struct DPTable {
+    std::vector<Vertex_Id> bag;
+    SpillableBuffer<typename Problem::Value> values;
+
+    // Returns the position of `v_id` in this table's bag.
+    size_t position(Vertex_Id v_id) const {
+        return std::lower_bound(bag.begin(), bag.end(), v_id) - bag.begin();
+    }
+
+    size_t size() const {
+        return tableSize<Problem::STATES>(bag.size());
+    }
+};
+
+/*
+Dynamic program over a rooted tree decomposition for the problem given by the policy `Problem`. The tree decomposition has to be nice unless the problem supports fused transitions, in which case the bags of adjacent nodes may differ arbitrarily and nodes may have any number of children.
+*/
+template<DPProblem Problem>
+class TreeDecompositionDP {
+    static_assert(Problem::STATES == 2 || (!Problem::HAS_WITNESS && !Problem::FUSED_TRANSITIONS), "Witnesses and fused transitions require binary states.");
+
+public:
+    using Value = typename Problem::Value;
+    using Table = DPTable<Problem>;
+
+    // Solves on a flat copy of the rooted tree decomposition `td_`.
+    TreeDecompositionDP(const UndirectedGraph& graph_, const TreeDecomposition& td_) : graph(graph_), owned_td(std::in_place, td_), td(*owned_td) {}
+
+    // Solves on `td_`, which has to outlive this object.
+    TreeDecompositionDP(const UndirectedGraph& graph_, const FlatTreeDecomposition& td_) : graph(graph_), td(td_) {}
+
+    // Solves the instance. With `num_threads` > 1, independent subtrees are evaluated concurrently on a work-stealing thread pool.
+    typename Problem::Solution solve(size_t num_threads = 1);
+
+    std::unordered_map<Node_Id, Table>M;
+
+    // Returns the peak number of live table entries predicted for the schedule of the last sequential solve.
+    double getPredictedPeakEntries() const;
+
+    // Returns the peak number of live table entries observed during the last solve.
+    size_t getObservedPeakEntries() const;
+
+    /*
+    Returns a post-order of the tree decomposition in which the children of every node are ordered by decreasing memory demand of their subtree beyond their own table (as in Sethi-Ullman register allocation), which minimizes the peak number of live table entries.
+    `predicted_peak_entries` is set to that peak.
+    */
+    std::vector<Node_Id> memoryAwarePostOrder(double& predicted_peak_entries) const;
+
+    // Tables and choices at least `options.threshold_bytes` large are kept in memory-mapped temporary files from now on.
+    void setSpillOptions(const SpillOptions& options);
+
+    const TableArena<Value>& getArena() const;
+
+    // Predicts the resources of `solve(num_threads)` from the bag sizes alone, without computing any table.
+    SolveEstimate estimate(size_t num_threads = 1) const;
+
+    // `callback` is called with the estimated fraction of work done after every node of the following solves. It may be called from several threads, but never concurrently.
+    void setProgressCallback(std::function<void(double)> callback);
+
+private:
+    const UndirectedGraph& graph;
+    std::optional<FlatTreeDecomposition> owned_td;
+    const FlatTreeDecomposition& td;
+
+    // Guards the structure of `M`, `forget_choices` and `transition_choices` while solving in parallel. The tables themselves are only ever touched by the task computing them and, once that is done, by the task of their parent.
+    std::mutex M_mutex;
+
+    SpillOptions spill_options;
+
+    // Recycles the buffers of consumed tables.
+    TableArena<Value> arena;
+
+    double predicted_peak_entries = 0;
+    size_t live_entries = 0;
+    size_t peak_live_entries = 0;
+
+    std::function<void(double)> progress_callback;
+    double estimated_work = 0;
+    double done_work = 0;
+
+    // Returns the entries read and written to compute the table of `t_id` from the tables of its children. `entries` is set to the number of entries of all tables created on the way and `choice_bytes` to the size of the choices kept for its children.
+    double nodeWork(Node_Id t_id, double& entries, double& choice_bytes) const;
+
+    // Throws std::invalid_argument if the problem needs a nice tree decomposition and `td` is not.
+    void checkTreeDecomposition() const;
+
+    // Computes the table of `t_id` from the tables of its children and discards the latter.
+    void computeNode(Node_Id t_id);
+
+    void solveSequential();
+
+    void solveParallel(size_t num_threads);
+
+    // For every node whose parent forgets exactly one of its vertices and every entry of the parent's table: Whether the forgotten vertex is in state 1 for the best entry. This is all that is needed to reconstruct the solution once the tables are gone.
+    std::unordered_map<Node_Id, SpillableBuffer<uint64_t>> forget_choices;
+
+    // The same for every node whose bag differs from its parent's bag in more than one vertex: The states of the forgotten vertices of the best entry, indexed by the states of the common vertices (see `computeTransition`).
+    std::unordered_map<Node_Id, SpillableBuffer<uint32_t>> transition_choices;
+
+    // Walks the tree decomposition top-down starting with the entry `root_index` at the root and collects the vertices in state 1.
+    Vertex_Set reconstructSolution(size_t root_index) const;
+
+    // Returns the mask of all vertices in `table`'s bag that are neighbours of `v_id`.
+    Cover_Mask neighbourMask(const Table& table, Vertex_Id v_id) const;
+
+    // Introduces the vertices of the bag one by one into the table of the empty bag.
+    void computeLeaf(Table& table);
+
+    void computeIntroduce(Table& table, const Table& child, Vertex_Id v_id);
+
+    void computeForget(Table& table, const Table& child, Vertex_Id v_id, SpillableBuffer<uint64_t>& choices);
+
+    // Forgets and introduces any number of vertices at once to get from `child`'s bag to `table`'s bag.
+    void computeTransition(Table& table, const Table& child, SpillableBuffer<uint32_t>& choices);
+
+    // Computes the table of `child_id` over `table`'s bag, moving `child`'s buffer if the bags are the same.
+    void computeBagChange(Table& table, Table& child, Node_Id child_id);
+
+    // Joins `other`, which has the same bag, into `table` in place.
+    void computeJoin(Table& table, const Table& other);
+};
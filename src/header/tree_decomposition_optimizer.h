@@ -0,0 +1,40 @@
+#pragma once
+
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/*
+Cost of solving on a tree decomposition: The DP stores STATES^|bag| entries per node, so the running time is governed by the total number of entries and the memory by the peak number of entries live at once when the children are computed in a memory-aware post-order (see `TreeDecompositionDP::memoryAwarePostOrder`), rather than by the width alone.
+*/
+struct DecompositionCostModel {
+    size_t states = 2;
+    // How many entries of total work a single entry of the peak is worth.
+    double peak_weight = 1.0;
+
+    // Returns the number of entries of a table over a bag of the given size.
+    double tableEntries(size_t bag_size) const;
+
+    double cost(double total_entries, double peak_entries) const { return total_entries + peak_weight * peak_entries; }
+};
+
+struct OptimizerOptions {
+    std::chrono::milliseconds time_budget{1000};
+    DecompositionCostModel cost_model;
+    uint64_t seed = 0;
+};
+
+// Returns the cost of `td` under `model`, summing the entries of all its nodes. The peak is taken with the root of `td`, or the one `TreeDecomposition::rootTree` picks if it is unrooted.
+double decompositionCost(const TreeDecomposition& td, const DecompositionCostModel& model);
+
+// Returns an elimination ordering whose induced tree decomposition (see `TreeDecomposition::fromEliminationOrdering`) has no bag that is not contained in a bag of `td`: Vertices are eliminated bottom-up at the topmost node containing them.
+std::vector<Vertex_Id> eliminationOrderingOf(const UndirectedGraph& graph, const TreeDecomposition& td);
+
+/*
+Local search for a tree decomposition of `graph` with lower cost than `td` within the time budget. The search starts from the elimination ordering of `td` and repeatedly moves single vertices to nearby positions, keeping a move unless it increases the cost. As the tree decomposition is rebuilt from the ordering, moves amount to splitting bags and re-attaching subtrees.
+Returns a copy of `td` if no better tree decomposition is found and an unrooted tree decomposition otherwise.
+*/
+TreeDecomposition optimizeTreeDecomposition(const UndirectedGraph& graph, const TreeDecomposition& td, const OptimizerOptions& options);
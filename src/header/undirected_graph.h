@@ -1,13 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <cstdio>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 
 using Vertex_Id = std::size_t;
 using Vertex_Weight = int;
-using UndirectedGraphAdjacencies = std::vector<std::vector<Vertex_Id>>;
 using Edge = std::pair<Vertex_Id, Vertex_Id>;
 
 /*
@@ -15,22 +18,35 @@ Class for undirected graphs (with number labels for vertices) as required for th
 */
 class UndirectedGraph {
     std::vector<Vertex_Id> vertices;
-    UndirectedGraphAdjacencies adjacencies;
     std::vector<Edge> edges;
 
+    // Compressed sparse rows built by `freeze` once all edges are added: The neighbours of v are neighbours[neighbour_offsets[v]] up to neighbours[neighbour_offsets[v + 1]], sorted by id and without duplicates.
+    std::vector<size_t> neighbour_offsets;
+    std::vector<Vertex_Id> neighbours;
+
+    // For graphs with at most MAX_MATRIX_IDS vertex ids, one bit per pair of ids, so that `areNeighbours` is a single lookup. Rows have `matrix_row_words` words.
+    static constexpr size_t MAX_MATRIX_IDS = size_t{1} << 13;
+    std::vector<uint64_t> adjacency_matrix;
+    size_t matrix_row_words = 0;
+
     // The names of the vertices (usually just numbers). This is *not* the label of the vertex, because the labels represent a vertices' weight.
     std::vector<std::string> vertex_id_to_name;
     std::vector<Vertex_Weight> vertex_id_to_weight;
     std::unordered_map<std::string, Vertex_Id> vertex_name_to_id;
 
+    // Vertices named by small non-negative integers (as in all our inputs) are found by indexing with that integer instead of hashing their names, unless the integer was far larger than the number of vertices when the vertex was added. NO_VERTEX marks unused integers.
+    static constexpr Vertex_Id NO_VERTEX = SIZE_MAX;
+    std::vector<Vertex_Id> numeric_name_to_id;
+
     size_t next_free_id = 0;
 
 public:
+    // Parses a graph in the CSV format or, if the file ends with .gr or starts with a "p tw" line, in the PACE 2017 format (all weights are 1).
     static UndirectedGraph parseUnsafe(const std::string& input_path);
 
     std::string idToName(Vertex_Id v_id) const;
 
-    Vertex_Id nameToId(const std::string& name) const;
+    Vertex_Id nameToId(std::string_view name) const;
 
     size_t numberOfNodes() const;
 
@@ -42,20 +58,43 @@ public:
 
     const Vertex_Weight getWeight(Vertex_Id v_id) const;
 
-    const std::vector<Vertex_Id>& getNeighbours(Vertex_Id v_id) const;
+    // Returns the neighbours of `v_id` sorted by id.
+    std::span<const Vertex_Id> getNeighbours(Vertex_Id v_id) const;
 
+    // Takes constant time if the graph has an adjacency matrix and otherwise time logarithmic in the smaller degree.
     bool areNeighbours(Vertex_Id v_id1, Vertex_Id v_id2) const;
 
+    // Returns the graph on `kept_vertices` with the given edges and weights (indexed by vertex id). The vertices keep their ids and names.
+    UndirectedGraph reducedGraph(const std::vector<Vertex_Id>& kept_vertices, const std::vector<Edge>& new_edges, const std::vector<Vertex_Weight>& weights) const;
+
     friend
     std::ostream& operator<<(std::ostream& stream, const UndirectedGraph& graph);
 
+    friend class Snapshot;
+
 private:
 
+    static UndirectedGraph parseCsv(std::string_view contents);
+
+    static UndirectedGraph parsePace(std::string_view contents);
+
     // adds new vertex with given name if this vertex has not been added before
-    Vertex_Id addVertex(const std::string& name);
+    Vertex_Id addVertex(std::string_view name);
+
+    // Makes the vertex findable by its name, which has to be new.
+    void indexName(Vertex_Id v_id);
+
+    // Returns the id of the vertex with the given name if there is one.
+    std::optional<Vertex_Id> findVertex(std::string_view name) const;
 
     void setWeight(Vertex_Id v_id, Vertex_Weight label);
 
     // adds new edge. If the edge_type is different than what was previously seen, instead returns false
     void addEdge(Vertex_Id v_id1, Vertex_Id v_id2);
+
+    // Builds the sorted neighbour lists from `edges`, afterwards no edges may be added.
+    void freeze();
+
+    // Builds the adjacency matrix from the neighbour lists if the graph is small enough.
+    void indexNeighbours();
 };
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <charconv>
 #include <iostream>
 #include <optional>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -9,6 +12,42 @@
 
 std::vector<std::string> stringSplit(const std::string& str, char delim);
 
+// Calls `f` with every part of `str` between two occurrences of `delim`, like `stringSplit` but without copying the parts.
+template<typename F>
+void forEachToken(std::string_view str, char delim, F&& f) {
+    while (!str.empty()) {
+        const size_t end = str.find(delim);
+        f(str.substr(0, end));
+        if (end == std::string_view::npos)
+            return;
+        str.remove_prefix(end + 1);
+    }
+}
+
+// Calls `f` with every non-empty line of `text`, without its line break (\n or \r\n).
+template<typename F>
+void forEachLine(std::string_view text, F&& f) {
+    forEachToken(text, '\n', [&f](std::string_view line) {
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty())
+            f(line);
+    });
+}
+
+// Returns the first non-empty line of `text` that does not start with `comment_prefix`, or an empty view.
+std::string_view firstContentLine(std::string_view text, char comment_prefix);
+
+// Returns the number `str` consists of, if it is one.
+template<typename T>
+std::optional<T> parseNumber(std::string_view str) {
+    T number;
+    const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), number);
+    if (error != std::errc{} || end != str.data() + str.size())
+        return std::nullopt;
+    return number;
+}
+
 bool endsWith(const std::string& str, const std::string& end);
 
 std::string stripToFilename(const std::string& path);
@@ -20,6 +59,11 @@ bool contains(const std::vector<T>& vec, const T& elem) {
     return std::find(vec.begin(), vec.end(), elem) != vec.end();
 }
 
+template<typename T>
+bool contains(std::span<const T> span, const T& elem) {
+    return std::find(span.begin(), span.end(), elem) != span.end();
+}
+
 template<typename T>
 bool contains(const std::unordered_set<T>& set, const T& elem) {
     return set.find(elem) != set.end();
@@ -102,16 +146,6 @@ std::unordered_set<T> filter(const std::unordered_set<T>& set, std::function<boo
     return set2;
 }
 
-//// Unit testing utilities ////
-
-template<typename T>
-bool returnAndOutputOnFailure(const T& expected, const T& got) {
-    bool success = expected == got;
-    if (!success)
-        std::cout << "Expected: " << expected << ". Got: " << got << std::endl;
-    return success;
-}
-
 //// Pretty printing ////
 
 template<typename T>
@@ -166,6 +200,16 @@ std::ostream& operator<<(std::ostream& stream, const std::unordered_map<T1,T2>&
     return stream;
 }
 
+//// Unit testing utilities ////
+
+template<typename T>
+bool returnAndOutputOnFailure(const T& expected, const T& got) {
+    bool success = expected == got;
+    if (!success)
+        std::cout << "Expected: " << expected << ". Got: " << got << std::endl;
+    return success;
+}
+
 //// For hashing ////
 
 template<typename T>
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "util.h"
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+
+#include <optional>
+
+/*
+Kernelization for MINIMUM WEIGHTED VERTEX COVER. The following rules are applied exhaustively (v is the vertex they are applied to, weights are the current ones):
+    I   Isolated vertex ... v has no neighbours: v is not part of the cover.
+    II  Degree 1        ... v has the single neighbour u. If w(u) <= w(v), u is part of the cover. Otherwise, the weight of v is shifted onto the edge: v is removed and w(u) decreases by w(v), as v is in the cover iff u is not.
+    III Degree 2        ... v has two non-adjacent neighbours a and b. If w(a) + w(b) <= w(v), both are part of the cover. Otherwise, if w(a), w(b) <= w(v), some optimal cover contains either v or both a and b: a and b are folded into v, which gets the weight w(a) + w(b) - w(v) and the neighbours of a and b.
+    IV  Domination      ... v has a neighbour u with N[v] ⊆ N[u] and w(u) <= w(v): u is part of the cover.
+The reduced graph keeps the ids of the original graph, so that the solution of the reduced instance can be lifted back to the original one by undoing the rules in reverse order.
+*/
+class VertexCoverReduction {
+public:
+    explicit VertexCoverReduction(const UndirectedGraph& graph);
+
+    const UndirectedGraph& getReducedGraph() const;
+
+    // Returns a tree decomposition of the reduced graph derived from the tree decomposition `td` of the original graph. Its width is at most the width of `td`.
+    TreeDecomposition reduceTreeDecomposition(const TreeDecomposition& td) const;
+
+    // Turns a solution of the reduced graph into a solution of the original graph.
+    Solution lift(const Solution& reduced_solution) const;
+
+    // The weight every cover of the original graph has on top of the corresponding cover of the reduced graph.
+    Vertex_Cover_Weight getWeightOffset() const;
+
+    size_t numberOfRemovedVertices() const;
+
+private:
+    enum class Rule { Take, WeightShift, Fold };
+
+    // A step that has to be undone to lift a solution: `v_id` was taken into the cover, shifted its weight onto its neighbour `u_id` or absorbed its neighbours `u_id` and `w_id`.
+    struct Step {
+        Rule rule;
+        Vertex_Id v_id;
+        Vertex_Id u_id = 0;
+        Vertex_Id w_id = 0;
+    };
+
+    const UndirectedGraph& original_graph;
+    UndirectedGraph reduced_graph;
+
+    std::vector<Step> steps;
+    Vertex_Cover_Weight weight_offset = 0;
+
+    // Maps every vertex of the original graph to the vertex of the reduced graph that represents it, if any.
+    std::vector<std::optional<Vertex_Id>> vertex_map;
+};
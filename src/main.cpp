@@ -1,9 +1,20 @@
 #include "undirected_graph.h"
 #include "tree_decomposition.h"
 #include "min_weighted_vertex_cover.h"
+#include "max_weighted_independent_set.h"
+#include "three_coloring.h"
+#include "vertex_cover_reduction.h"
+#include "elimination_ordering.h"
+#include "tree_decomposition_optimizer.h"
+#include "snapshot.h"
+#include "flat_tree_decomposition.h"
 #include "util.h"
 
+#include <filesystem>
 #include <iostream>
+#include <stdexcept>
+
+#include <unistd.h>
 
 using std::cout;
 using std::endl;
@@ -12,21 +23,228 @@ void printUsage(const std::string& errorMessage)
 {
     cout << "Error: " << errorMessage << endl;
     printf("Usage:\n"
-       "./main <graph-infile> <td-infile>\n"
+       "./main <graph-infile> [<td-infile>] [options]\n"
+       "./main --load-snapshot FILE [options]\n"
        "\n"
        "Description:\n"
        "    Runs the MINIMUM_WEIGHT_VERTEX_COVER solver on the given graph infile using the given tree decomposition.\n"
+       "    Without a tree decomposition, one is computed with the min-fill heuristic.\n"
+       "    Both files are read as CSV or, if they end with .gr/.td or start with a PACE header, in the PACE 2017 format.\n"
+       "    Instead, the graph and its prepared tree decomposition can be loaded from a binary snapshot.\n"
+       "\n"
+       "Options:\n"
+       "    --problem P              Solves P instead: vertex-cover (default), independent-set (maximum weight) or\n"
+       "                             3-coloring (number of colorings).\n"
+       "    --threads N              Evaluates independent subtrees of the tree decomposition on N threads (default: 1).\n"
+       "    --spill-threshold BYTES  Keeps DP tables of at least BYTES bytes in memory-mapped temporary files instead of RAM.\n"
+       "    --spill-dir DIR          Directory for those files (default: $TMPDIR or /tmp).\n"
+       "    --huge-pages             Backs DP tables of at least 2 MiB that stay in RAM by transparent huge pages.\n"
+       "    --fused-transitions      Solves on the given tree decomposition instead of a nice one, introducing and forgetting\n"
+       "                             all vertices between two adjacent bags in a single pass (only for vertex-cover).\n"
+       "    --elimination H          Computes the tree decomposition from the elimination ordering of the heuristic H:\n"
+       "                             min-degree or min-fill (default). Cannot be combined with a td-infile.\n"
+       "    --root-selection R       Roots the tree decomposition at a node with the largest bag (largest-bag, default) or at\n"
+       "                             the node with the lowest estimated solving cost (min-cost).\n"
+       "    --join-tree S            Joins the children of a node in the nice tree decomposition as a caterpillar (default),\n"
+       "                             a balanced binary tree (balanced) or by subtree cost (weighted).\n"
+       "    --optimize-td MS         Spends up to MS milliseconds searching for a tree decomposition with smaller DP tables.\n"
+       "    --max-memory BYTES       Aborts before solving if the predicted peak memory of the DP tables exceeds BYTES. With\n"
+       "                             --threads, all tables are assumed to be live at once.\n"
+       "    --max-work ENTRIES       Aborts before solving if the predicted number of table entries read and written by the\n"
+       "                             kernels exceeds ENTRIES.\n"
+       "    --progress               Reports the fraction of the predicted work done while solving on stderr.\n"
+       "    --reduce                 Shrinks the graph with vertex cover reduction rules before solving and lifts the\n"
+       "                             solution back (only for vertex-cover).\n"
+       "    --save-snapshot FILE     Writes the graph and the rooted (nice) tree decomposition to FILE before solving.\n"
+       "    --load-snapshot FILE     Reads the graph and the tree decomposition from FILE instead of the infiles and skips\n"
+       "                             computing, rooting and optimizing the tree decomposition.\n"
       );
 }
 
-bool parseArguments(int argc, char* argv[], std::string& input_path, std::string& td_input_path) {
-    if (argc < 3) {
-        printUsage("At least 2 arguments expected.");
+struct Options {
+    std::string problem = "vertex-cover";
+    size_t num_threads = 1;
+    SpillOptions spill_options;
+    bool fused_transitions = false;
+    bool reduce = false;
+    std::optional<EliminationHeuristic> elimination;
+    std::optional<std::chrono::milliseconds> optimization_budget;
+    RootSelection root_selection = RootSelection::LargestBag;
+    JoinTreeShape join_tree_shape = JoinTreeShape::Caterpillar;
+    std::optional<double> max_memory;
+    std::optional<double> max_work;
+    bool progress = false;
+    std::string save_snapshot;
+    std::string load_snapshot;
+};
+
+bool parseArguments(int argc, char* argv[], std::string& input_path, std::string& td_input_path, Options& options) {
+    if (argc < 2) {
+        printUsage("At least 1 argument expected.");
         return false;
     }
-    input_path = argv[1];
-    td_input_path = argv[2];
 
+    // The graph-infile may only be omitted when loading a snapshot.
+    int i = 1;
+    if (std::string(argv[i]).rfind("--", 0) != 0)
+        input_path = argv[i++];
+    if (!input_path.empty() && i < argc && std::string(argv[i]).rfind("--", 0) != 0)
+        td_input_path = argv[i++];
+
+    for (; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--problem" && i + 1 < argc) {
+            options.problem = argv[++i];
+            if (options.problem != "vertex-cover" && options.problem != "independent-set" && options.problem != "3-coloring") {
+                printUsage("Unknown problem " + options.problem + ".");
+                return false;
+            }
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            try {
+                options.num_threads = std::stoul(argv[++i]);
+            }
+            catch (const std::exception&) {
+                printUsage("--threads expects a number.");
+                return false;
+            }
+        }
+        else if (arg == "--spill-threshold" && i + 1 < argc) {
+            try {
+                options.spill_options.threshold_bytes = std::stoull(argv[++i]);
+            }
+            catch (const std::exception&) {
+                printUsage("--spill-threshold expects a number of bytes.");
+                return false;
+            }
+        }
+        else if (arg == "--spill-dir" && i + 1 < argc) {
+            options.spill_options.directory = argv[++i];
+        }
+        else if (arg == "--huge-pages") {
+            options.spill_options.use_huge_pages = true;
+        }
+        else if (arg == "--fused-transitions") {
+            options.fused_transitions = true;
+        }
+        else if (arg == "--elimination" && i + 1 < argc) {
+            try {
+                options.elimination = parseEliminationHeuristic(argv[++i]);
+            }
+            catch (const std::invalid_argument& e) {
+                printUsage(e.what());
+                return false;
+            }
+        }
+        else if (arg == "--root-selection" && i + 1 < argc) {
+            const std::string selection = argv[++i];
+            if (selection == "largest-bag")
+                options.root_selection = RootSelection::LargestBag;
+            else if (selection == "min-cost")
+                options.root_selection = RootSelection::MinimumCost;
+            else {
+                printUsage("Unknown root selection " + selection + ".");
+                return false;
+            }
+        }
+        else if (arg == "--join-tree" && i + 1 < argc) {
+            const std::string shape = argv[++i];
+            if (shape == "caterpillar")
+                options.join_tree_shape = JoinTreeShape::Caterpillar;
+            else if (shape == "balanced")
+                options.join_tree_shape = JoinTreeShape::Balanced;
+            else if (shape == "weighted")
+                options.join_tree_shape = JoinTreeShape::Weighted;
+            else {
+                printUsage("Unknown join tree shape " + shape + ".");
+                return false;
+            }
+        }
+        else if (arg == "--optimize-td" && i + 1 < argc) {
+            try {
+                options.optimization_budget = std::chrono::milliseconds{std::stoull(argv[++i])};
+            }
+            catch (const std::exception&) {
+                printUsage("--optimize-td expects a number of milliseconds.");
+                return false;
+            }
+        }
+        else if (arg == "--max-memory" && i + 1 < argc) {
+            try {
+                options.max_memory = std::stod(argv[++i]);
+            }
+            catch (const std::exception&) {
+                printUsage("--max-memory expects a number of bytes.");
+                return false;
+            }
+        }
+        else if (arg == "--max-work" && i + 1 < argc) {
+            try {
+                options.max_work = std::stod(argv[++i]);
+            }
+            catch (const std::exception&) {
+                printUsage("--max-work expects a number of table entries.");
+                return false;
+            }
+        }
+        else if (arg == "--progress") {
+            options.progress = true;
+        }
+        else if (arg == "--reduce") {
+            options.reduce = true;
+        }
+        else if (arg == "--save-snapshot" && i + 1 < argc) {
+            options.save_snapshot = argv[++i];
+        }
+        else if (arg == "--load-snapshot" && i + 1 < argc) {
+            options.load_snapshot = argv[++i];
+        }
+        else {
+            printUsage("Unknown argument " + arg + ".");
+            return false;
+        }
+    }
+
+    // Spilling creates its files only once the first large table is computed, the directory is checked up front.
+    if (options.spill_options.threshold_bytes != SIZE_MAX) {
+        const std::string& directory = options.spill_options.directory;
+        if (!std::filesystem::is_directory(directory) || access(directory.c_str(), W_OK | X_OK) != 0) {
+            printUsage("The spill directory " + directory + " does not exist or is not writable.");
+            return false;
+        }
+    }
+
+    if (options.fused_transitions && options.problem != "vertex-cover") {
+        printUsage("--fused-transitions is only available for vertex-cover.");
+        return false;
+    }
+    if (options.reduce && options.problem != "vertex-cover") {
+        printUsage("--reduce is only available for vertex-cover.");
+        return false;
+    }
+
+    if (!options.load_snapshot.empty()) {
+        if (!input_path.empty() || options.elimination.has_value() || options.optimization_budget.has_value() || options.reduce) {
+            printUsage("--load-snapshot cannot be combined with infiles, --elimination, --optimize-td or --reduce.");
+            return false;
+        }
+        return true;
+    }
+    if (input_path.empty()) {
+        printUsage("A graph-infile or --load-snapshot is expected.");
+        return false;
+    }
+    if (options.reduce && !options.save_snapshot.empty()) {
+        printUsage("--save-snapshot cannot be combined with --reduce.");
+        return false;
+    }
+
+    if (options.elimination.has_value() && !td_input_path.empty()) {
+        printUsage("--elimination cannot be combined with a td-infile.");
+        return false;
+    }
+    if (td_input_path.empty() && !options.elimination.has_value())
+        options.elimination = EliminationHeuristic::MinFill;
     return true;
 }
 
@@ -42,23 +260,163 @@ void outputSolution(const UndirectedGraph& graph, const Solution& solution) {
     cout << "Weight: " << solution.total_weight << endl;
 }
 
+void outputSolution(const UndirectedGraph& graph, const IndependentSetSolution& solution) {
+    std::vector<Vertex_Id>independent_set_vector{solution.independent_set.begin(), solution.independent_set.end()};
+
+    cout << "Maximum Independent Set: {";
+    for (size_t i = 0; i < independent_set_vector.size(); i++) {
+        Vertex_Id v_id = independent_set_vector[i];
+        cout << graph.idToName(v_id) << (i == independent_set_vector.size() - 1 ? "" : " ");
+    }
+    cout << "}" << endl;
+    cout << "Weight: " << solution.total_weight << endl;
+}
+
+void outputSolution(const UndirectedGraph&, const Coloring_Count& count) {
+    cout << "Number of 3-colorings: " << count << endl;
+}
+
+// Returns nothing if the predicted resources exceed the budgets of `options`.
+template<DPProblem Problem>
+std::optional<typename Problem::Solution> solve(const UndirectedGraph& graph, const FlatTreeDecomposition& td, const Options& options) {
+    TreeDecompositionDP<Problem> solver{graph, td};
+    solver.setSpillOptions(options.spill_options);
+
+    // With several threads, only an upper bound of the peak memory is known.
+    const SolveEstimate estimate = solver.estimate(options.num_threads);
+    cout << "Predicted table entries: " << estimate.total_entries << endl;
+    cout << "Predicted work (entries read and written): " << estimate.work << endl;
+    if (options.num_threads <= 1)
+        cout << "Predicted peak memory (sequential): " << estimate.peak_bytes << " bytes" << endl;
+    else
+        cout << "Bound on peak memory (" << options.num_threads << " threads): " << estimate.peak_bytes << " bytes" << endl;
+    if (options.max_memory.has_value() && estimate.peak_bytes > options.max_memory.value()) {
+        cout << "Aborting: The predicted peak memory exceeds --max-memory " << options.max_memory.value() << "." << endl;
+        return std::nullopt;
+    }
+    if (options.max_work.has_value() && estimate.work > options.max_work.value()) {
+        cout << "Aborting: The predicted work exceeds --max-work " << options.max_work.value() << "." << endl;
+        return std::nullopt;
+    }
+
+    if (options.progress) {
+        // Only whole percents are reported.
+        solver.setProgressCallback([reported = -1](double fraction) mutable {
+            const int percent = int(fraction * 100);
+            if (percent == reported)
+                return;
+            reported = percent;
+            std::cerr << "\rProgress: " << percent << "%" << (percent == 100 ? "\n" : "") << std::flush;
+        });
+    }
+    cout << "Starting to solve..." << endl;
+    auto solution = solver.solve(options.num_threads);
+    if (options.num_threads <= 1)
+        cout << "Predicted peak of live table entries: " << solver.getPredictedPeakEntries() << endl;
+    cout << "Observed peak of live table entries: " << solver.getObservedPeakEntries() << endl;
+    cout << "Reused table buffers: " << solver.getArena().numberOfReusedBuffers() << " of " << solver.getArena().numberOfAcquiredBuffers() << endl;
+    return solution;
+}
+
+RootingCostModel rootingCostModel(const Options& options) {
+    RootingCostModel model;
+    model.states = options.problem == "3-coloring" ? 3 : 2;
+    return model;
+}
+
+// Computes or parses the tree decomposition of `solved_graph`, optimizes it if requested and roots it.
+TreeDecomposition prepareTreeDecomposition(const UndirectedGraph& graph, const UndirectedGraph& solved_graph, const std::optional<VertexCoverReduction>& reduction, const std::string& td_input_path, const Options& options) {
+    // A heuristic tree decomposition is computed for the graph that is actually solved, a given one is adapted to it.
+    TreeDecomposition td = options.elimination.has_value()
+        ? TreeDecomposition::fromEliminationOrdering(solved_graph, computeEliminationOrdering(solved_graph, options.elimination.value()))
+        : TreeDecomposition::parseUnsafe(td_input_path, graph);
+    if (reduction.has_value() && !options.elimination.has_value())
+        td = reduction->reduceTreeDecomposition(td);
+
+    if (options.optimization_budget.has_value()) {
+        OptimizerOptions optimizer_options;
+        optimizer_options.time_budget = options.optimization_budget.value();
+        optimizer_options.cost_model.states = options.problem == "3-coloring" ? 3 : 2;
+        const double cost_before = decompositionCost(td, optimizer_options.cost_model);
+        td = optimizeTreeDecomposition(solved_graph, td, optimizer_options);
+        cout << "Optimized tree decomposition cost from " << cost_before << " to " << decompositionCost(td, optimizer_options.cost_model) << "." << endl;
+    }
+
+    td.rootTree(options.root_selection, rootingCostModel(options));
+    return td;
+}
+
+// Makes the rooted `td` nice unless solving with fused transitions, flattens it for solving and saves it if requested.
+FlatTreeDecomposition flattenTreeDecomposition(const UndirectedGraph& graph, const TreeDecomposition& td, const Options& options) {
+    if (!options.fused_transitions)
+        cout << "Turn into nice tree decomposition..." << endl;
+    FlatTreeDecomposition flat_td = options.fused_transitions ? FlatTreeDecomposition{td} : FlatTreeDecomposition::nice(td, options.join_tree_shape);
+    if (!options.save_snapshot.empty()) {
+        Snapshot::save(options.save_snapshot, graph, flat_td);
+        cout << "Saved snapshot to " << options.save_snapshot << "." << endl;
+    }
+    return flat_td;
+}
+
+// The flat tree decomposition of the snapshot is solved on as it is, unless it was saved with fused transitions and has to be made nice now.
+FlatTreeDecomposition loadTreeDecomposition(const Snapshot& snapshot, const UndirectedGraph& graph, const Options& options) {
+    if (options.fused_transitions || snapshot.isNice())
+        return snapshot.flatTreeDecomposition();
+    cout << "Turn into nice tree decomposition..." << endl;
+    return FlatTreeDecomposition::nice(snapshot.treeDecomposition(graph), options.join_tree_shape);
+}
+
 int main(int argc, char* argv[]) {
     std::string input_path;
     std::string td_input_path;
+    Options options;
 
-    if (!parseArguments(argc, argv, input_path, td_input_path))
+    if (!parseArguments(argc, argv, input_path, td_input_path, options))
         return 1;
 
-    UndirectedGraph graph = UndirectedGraph::parseUnsafe(input_path);
-    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_input_path, graph);
+    std::optional<Snapshot> snapshot;
+    if (!options.load_snapshot.empty())
+        snapshot.emplace(options.load_snapshot);
 
-    td.rootTree();
-    cout << "Turn into nice tree decomposition..." << endl;
-    td.turnIntoNiceTreeDecomposition();
+    UndirectedGraph graph = snapshot.has_value() ? snapshot->graph() : UndirectedGraph::parseUnsafe(input_path);
+
+    std::optional<VertexCoverReduction> reduction;
+    if (options.reduce) {
+        reduction.emplace(graph);
+        cout << "Reduction removed " << reduction->numberOfRemovedVertices() << " of " << graph.numberOfNodes() << " vertices." << endl;
+    }
+    const UndirectedGraph& solved_graph = reduction.has_value() ? reduction->getReducedGraph() : graph;
+
+    // The hash-based tree decomposition is only kept until it is flattened for solving, a snapshot holds the flat one.
+    const FlatTreeDecomposition td = snapshot.has_value()
+        ? loadTreeDecomposition(snapshot.value(), graph, options)
+        : flattenTreeDecomposition(graph, prepareTreeDecomposition(graph, solved_graph, reduction, td_input_path, options), options);
 
-    MinWeightedVertexCover solver{graph, td};
     cout << "Tree decomposition has treewidth " << td.getTreewidth() << "." << endl;
-    cout << "Starting to solve..." << endl;
-    auto solution = solver.solve();
-    outputSolution(graph, solution);
+    cout << "Using " << simdLevelName(getSimdLevel()) << " kernels." << endl;
+    // Exits with 2 if a budget is exceeded and with 1 if solving fails, e.g. because a table cannot be spilled.
+    try {
+        if (options.problem == "independent-set") {
+            const auto solution = solve<IndependentSetProblem>(graph, td, options);
+            if (!solution.has_value())
+                return 2;
+            outputSolution(graph, solution.value());
+        }
+        else if (options.problem == "3-coloring") {
+            const auto count = solve<ThreeColoringProblem>(graph, td, options);
+            if (!count.has_value())
+                return 2;
+            outputSolution(graph, count.value());
+        }
+        else {
+            const auto solution = solve<VertexCoverProblem>(solved_graph, td, options);
+            if (!solution.has_value())
+                return 2;
+            outputSolution(graph, reduction.has_value() ? reduction->lift(solution.value()) : solution.value());
+        }
+    }
+    catch (const std::runtime_error& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
 }
\ No newline at end of file
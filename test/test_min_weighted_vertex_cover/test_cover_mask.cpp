@@ -0,0 +1,34 @@
+#include "min_weighted_vertex_cover.h"
+#include "util.h"
+
+bool test_insert_bit() {
+    bool success = true;
+    success &= returnAndOutputOnFailure(Cover_Mask{0b1011}, insertBit(0b101, 1, 1));
+    success &= returnAndOutputOnFailure(Cover_Mask{0b1001}, insertBit(0b101, 1, 0));
+    success &= returnAndOutputOnFailure(Cover_Mask{0b1010}, insertBit(0b101, 0, 0));
+    success &= returnAndOutputOnFailure(Cover_Mask{0b1101}, insertBit(0b101, 3, 1));
+    return success;
+}
+
+bool test_remove_bit() {
+    bool success = true;
+    success &= returnAndOutputOnFailure(Cover_Mask{0b101}, removeBit(0b1011, 1));
+    success &= returnAndOutputOnFailure(Cover_Mask{0b101}, removeBit(0b1010, 0));
+    success &= returnAndOutputOnFailure(Cover_Mask{0b101}, removeBit(0b1101, 3));
+    for (Cover_Mask mask = 0; mask < 64; mask++) {
+        for (size_t pos = 0; pos < 6; pos++) {
+            success &= returnAndOutputOnFailure(mask, removeBit(insertBit(mask, pos, 1), pos));
+            success &= returnAndOutputOnFailure(mask, removeBit(insertBit(mask, pos, 0), pos));
+        }
+    }
+    return success;
+}
+
+int test_cover_mask(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_insert_bit();
+    success &= test_remove_bit();
+
+    return !success;
+}
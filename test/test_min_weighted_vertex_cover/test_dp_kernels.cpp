@@ -0,0 +1,176 @@
+#include "dp_kernels.h"
+#include "util.h"
+
+#include <random>
+
+using std::cout;
+using std::endl;
+
+std::vector<Vertex_Cover_Weight> randomTable(size_t size, std::mt19937& rng) {
+    std::uniform_int_distribution<Vertex_Cover_Weight> weight_distribution(0, 1000);
+    std::vector<Vertex_Cover_Weight> table(size);
+    for (auto& weight : table)
+        weight = rng() % 4 == 0 ? INVALID_COVER : weight_distribution(rng);
+    return table;
+}
+
+bool test_subset_weights() {
+    std::vector<Vertex_Cover_Weight> bag_weights{3, 5, 7, 11};
+    std::vector<Vertex_Cover_Weight> subset_weights;
+    computeSubsetWeights(bag_weights, subset_weights);
+
+    bool success = returnAndOutputOnFailure((size_t)16, subset_weights.size());
+    for (Cover_Mask U = 0; U < 16; U++) {
+        Vertex_Cover_Weight expected = 0;
+        for (size_t i = 0; i < 4; i++)
+            if (U >> i & 1)
+                expected += bag_weights[i];
+        success &= returnAndOutputOnFailure(expected, subset_weights[U]);
+    }
+
+    // The blocks cover all masks of a bag larger than SUBSET_LOW_BITS with the same weights.
+    std::vector<Vertex_Cover_Weight> large_bag_weights{3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    computeSubsetWeights(large_bag_weights, subset_weights);
+    size_t covered = 0;
+    forEachSubsetWeightBlock(large_bag_weights, subset_weights.size(), [&](size_t start, size_t block_size, const Vertex_Cover_Weight* low_weights, Vertex_Cover_Weight high_weight) {
+        success &= returnAndOutputOnFailure(covered, start);
+        for (Cover_Mask U = start; U < start + block_size; U++)
+            success &= returnAndOutputOnFailure(subset_weights[U], low_weights[U - start] + high_weight);
+        covered += block_size;
+    });
+    success &= returnAndOutputOnFailure(subset_weights.size(), covered);
+    return success;
+}
+
+bool test_join_kernel_matches_scalar() {
+    std::mt19937 rng(42);
+    bool success = true;
+    const SimdLevel default_level = getSimdLevel();
+
+    for (size_t bag_size = 0; bag_size <= 10; bag_size++) {
+        const size_t size = size_t{1} << bag_size;
+        std::vector<Vertex_Cover_Weight> bag_weights(bag_size);
+        for (auto& weight : bag_weights)
+            weight = rng() % 10;
+        std::vector<Vertex_Cover_Weight> subset_weights;
+        computeSubsetWeights(bag_weights, subset_weights);
+
+        // Valid entries always contain the weight of their subset.
+        auto left = randomTable(size, rng);
+        auto right = randomTable(size, rng);
+        for (Cover_Mask U = 0; U < size; U++) {
+            if (left[U] != INVALID_COVER) left[U] += subset_weights[U];
+            if (right[U] != INVALID_COVER) right[U] += subset_weights[U];
+        }
+
+        std::vector<Vertex_Cover_Weight> expected(size);
+        for (Cover_Mask U = 0; U < size; U++)
+            expected[U] = left[U] == INVALID_COVER || right[U] == INVALID_COVER ? INVALID_COVER : left[U] + right[U] - subset_weights[U];
+
+        setSimdLevel(SimdLevel::Scalar);
+        std::vector<Vertex_Cover_Weight> scalar(size);
+        joinKernel(left.data(), right.data(), bag_weights, scalar.data(), size);
+        if (scalar != expected) {
+            cout << "Scalar join is wrong for bag size " << bag_size << endl;
+            success = false;
+        }
+
+        for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+            if (!setSimdLevel(level))
+                continue;
+            std::vector<Vertex_Cover_Weight> got(size);
+            joinKernel(left.data(), right.data(), bag_weights, got.data(), size);
+            if (got != expected) {
+                cout << simdLevelName(level) << " join differs from scalar join for bag size " << bag_size << endl;
+                success = false;
+            }
+        }
+    }
+
+    setSimdLevel(default_level);
+    return success;
+}
+
+bool test_introduce_and_forget_kernels_match_scalar() {
+    std::mt19937 rng(7);
+    bool success = true;
+    const SimdLevel default_level = getSimdLevel();
+
+    for (size_t bag_size = 0; bag_size <= 9; bag_size++) {
+        const size_t size = size_t{1} << bag_size;
+        const auto child = randomTable(size, rng);
+
+        for (size_t pos = 0; pos <= bag_size; pos++) {
+            const Cover_Mask neighbour_mask = rng() & (size - 1);
+
+            setSimdLevel(SimdLevel::Scalar);
+            std::vector<Vertex_Cover_Weight> expected_introduce(2 * size);
+            introduceKernel(child.data(), expected_introduce.data(), size, pos, neighbour_mask, 13);
+
+            const size_t forget_size = size / 2;
+            std::vector<Vertex_Cover_Weight> expected_forget(forget_size);
+            Choice_Bits expected_choices((forget_size + 63) / 64, 0);
+            if (bag_size > 0 && pos < bag_size)
+                forgetKernel(child.data(), expected_forget.data(), expected_choices.data(), forget_size, pos);
+
+            for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+                if (!setSimdLevel(level))
+                    continue;
+
+                std::vector<Vertex_Cover_Weight> got_introduce(2 * size);
+                introduceKernel(child.data(), got_introduce.data(), size, pos, neighbour_mask, 13);
+                if (got_introduce != expected_introduce) {
+                    cout << simdLevelName(level) << " introduce differs from scalar introduce for bag size " << bag_size << ", position " << pos << endl;
+                    success = false;
+                }
+
+                if (bag_size == 0 || pos == bag_size)
+                    continue;
+                std::vector<Vertex_Cover_Weight> got_forget(forget_size);
+                Choice_Bits got_choices((forget_size + 63) / 64, 0);
+                forgetKernel(child.data(), got_forget.data(), got_choices.data(), forget_size, pos);
+                if (got_forget != expected_forget || got_choices != expected_choices) {
+                    cout << simdLevelName(level) << " forget differs from scalar forget for bag size " << bag_size << ", position " << pos << endl;
+                    success = false;
+                }
+            }
+        }
+    }
+
+    setSimdLevel(default_level);
+    return success;
+}
+
+bool test_scalar_introduce_and_forget() {
+    // Bag {a,b} with a at bit 0. Child table over {a}: {} -> 0, {a} -> 5
+    const std::vector<Vertex_Cover_Weight> child{0, 5};
+    const SimdLevel default_level = getSimdLevel();
+    setSimdLevel(SimdLevel::Scalar);
+
+    // Introduce b (bit 1, weight 3) which is a neighbour of a.
+    std::vector<Vertex_Cover_Weight> introduced(4);
+    introduceKernel(child.data(), introduced.data(), 2, 1, 0b1, 3);
+    bool success = returnAndOutputOnFailure(std::vector<Vertex_Cover_Weight>{INVALID_COVER, 5, 3, 8}, introduced);
+
+    // Forget a again.
+    std::vector<Vertex_Cover_Weight> forgotten(2);
+    Choice_Bits choices(1, 0);
+    forgetKernel(introduced.data(), forgotten.data(), choices.data(), 2, 0);
+    success &= returnAndOutputOnFailure(std::vector<Vertex_Cover_Weight>{5, 3}, forgotten);
+    success &= returnAndOutputOnFailure(true, getChoice(choices, 0));
+    success &= returnAndOutputOnFailure(false, getChoice(choices, 1));
+
+    setSimdLevel(default_level);
+    return success;
+}
+
+int test_dp_kernels(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_subset_weights();
+    success &= test_join_kernel_matches_scalar();
+    success &= test_scalar_introduce_and_forget();
+    success &= test_introduce_and_forget_kernels_match_scalar();
+
+    return !success;
+}
@@ -0,0 +1,55 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "util.h"
+
+using std::cout;
+using std::endl;
+
+bool test_predicted_peak_is_observed(const std::string& graph_path, const std::string& td_path) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    MinWeightedVertexCover solver{graph, td};
+    solver.solve();
+
+    return returnAndOutputOnFailure((size_t)solver.getPredictedPeakEntries(), solver.getObservedPeakEntries());
+}
+
+bool test_post_order_visits_children_first() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/k4_plus_4_appendages.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/k4_plus_4_appendages.td.csv", graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    MinWeightedVertexCover solver{graph, td};
+    double predicted_peak_entries;
+    std::vector<Node_Id> post_order = solver.memoryAwarePostOrder(predicted_peak_entries);
+
+    std::unordered_set<Node_Id> visited;
+    for (const Node_Id n_id : post_order) {
+        for (const Node_Id child_id : td.getNode(n_id).children) {
+            if (!contains(visited, child_id))
+                return false;
+        }
+        visited.insert(n_id);
+    }
+    return returnAndOutputOnFailure(td.getRoot(), post_order.back());
+}
+
+int test_memory_aware_post_order(int argc, char** argv) {
+    bool success = true;
+
+    std::vector<std::string>test_names{"cycle", "house", "k4_plus_2_appendages", "k4_plus_3_appendages", "k4_plus_4_appendages", "sigma_graph"};
+    for (const std::string& test_name : test_names) {
+        const std::string path = "test-instances/unit-test-instances/" + test_name;
+        success &= test_predicted_peak_is_observed(path + ".gr.csv", path + ".td.csv");
+    }
+    const std::string path = "test-instances/Treewidth-PACE-2017-Instances/ex001";
+    success &= test_predicted_peak_is_observed(path + ".gr.csv", path + ".td.csv");
+    success &= test_post_order_visits_children_first();
+
+    return !success;
+}
@@ -0,0 +1,96 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "max_weighted_independent_set.h"
+#include "three_coloring.h"
+#include "util.h"
+
+using std::cout;
+using std::endl;
+
+// The complement of a minimum weight vertex cover is a maximum weight independent set.
+bool test_independent_set(const std::string& graph_path, const std::string& td_path) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    MinWeightedVertexCover vertex_cover_solver{graph, td};
+    const Solution vertex_cover = vertex_cover_solver.solve();
+    MaxWeightedIndependentSet independent_set_solver{graph, td};
+    const IndependentSetSolution independent_set = independent_set_solver.solve();
+
+    Independent_Set_Weight total_weight = 0;
+    for (const Vertex_Id v_id : graph.getVertices())
+        total_weight += graph.getWeight(v_id);
+    bool success = returnAndOutputOnFailure(total_weight - vertex_cover.total_weight, independent_set.total_weight);
+
+    Independent_Set_Weight weight = 0;
+    for (const Vertex_Id v_id : independent_set.independent_set)
+        weight += graph.getWeight(v_id);
+    success &= returnAndOutputOnFailure(independent_set.total_weight, weight);
+    for (const Edge& edge : graph.getEdges()) {
+        if (contains(independent_set.independent_set, edge.first) && contains(independent_set.independent_set, edge.second)) {
+            cout << "Edge " << edge << " is inside the independent set." << endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+Coloring_Count countThreeColoringsBruteForce(const UndirectedGraph& graph) {
+    const auto& vertices = graph.getVertices();
+    std::unordered_map<Vertex_Id, size_t> color;
+    Coloring_Count count = 0;
+    for (size_t index = 0; index < tableSize<3>(vertices.size()); index++) {
+        size_t digits = index;
+        for (const Vertex_Id v_id : vertices) {
+            color[v_id] = digits % 3;
+            digits /= 3;
+        }
+        const auto& edges = graph.getEdges();
+        count += std::none_of(edges.begin(), edges.end(), [&color](const Edge& edge) { return color.at(edge.first) == color.at(edge.second); });
+    }
+    return count;
+}
+
+bool test_three_colorings(const std::string& graph_path, const std::string& td_path) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    ThreeColoringCounter solver{graph, td};
+    return returnAndOutputOnFailure(countThreeColoringsBruteForce(graph), solver.solve());
+}
+
+bool test_three_colorings_need_nice_tree_decomposition() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex001.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex001.td.csv", graph);
+    td.rootTree();
+
+    ThreeColoringCounter solver{graph, td};
+    try {
+        solver.solve();
+    }
+    catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+int test_problem_policies(int argc, char** argv) {
+    bool success = true;
+
+    std::vector<std::string>test_names{"cycle", "house", "k4_plus_2_appendages", "k4_plus_3_appendages", "k4_plus_4_appendages", "sigma_graph"};
+    for (const std::string& test_name : test_names) {
+        const std::string path = "test-instances/unit-test-instances/" + test_name;
+        success &= test_independent_set(path + ".gr.csv", path + ".td.csv");
+        success &= test_three_colorings(path + ".gr.csv", path + ".td.csv");
+    }
+    const std::string path = "test-instances/Treewidth-PACE-2017-Instances/ex001";
+    success &= test_independent_set(path + ".gr.csv", path + ".td.csv");
+    success &= test_three_colorings_need_nice_tree_decomposition();
+
+    return !success;
+}
@@ -8,6 +8,19 @@
 using std::cout;
 using std::endl;
 
+bool isVertexCoverOfWeight(const UndirectedGraph& graph, const Solution& solution) {
+    const auto& edges = graph.getEdges();
+    bool is_vertex_cover = std::all_of(edges.begin(), edges.end(), [&solution](const Edge& edge) {
+        return contains(solution.past_vertex_cover, edge.first) || contains(solution.past_vertex_cover, edge.second);
+    });
+
+    Vertex_Cover_Weight weight = 0;
+    for (const Vertex_Id v_id : solution.past_vertex_cover)
+        weight += graph.getWeight(v_id);
+
+    return is_vertex_cover && weight == solution.total_weight;
+}
+
 void solve_unit_test_instance(const std::string& graph_file, const std::string& td_file, int expected_min_vertex_cover_weight) {
     UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/" + graph_file);
     TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/" + td_file, graph);
@@ -21,6 +34,7 @@ void solve_unit_test_instance(const std::string& graph_file, const std::string&
     Solution solution = solver.solve();
 
     assert(doubleEqual(solution.total_weight, expected_min_vertex_cover_weight));
+    assert(isVertexCoverOfWeight(graph, solution));
 }
 
 bool solve_unit_test_instances() {
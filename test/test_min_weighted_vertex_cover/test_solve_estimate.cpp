@@ -0,0 +1,108 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "flat_tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "three_coloring.h"
+#include "util.h"
+
+#include <cmath>
+
+// Solves with a progress callback and checks that the reported fractions increase up to exactly 1.
+bool test_progress_reaches_estimated_work(const std::string& name, bool nice, size_t num_threads) {
+    const std::string path = "test-instances/Treewidth-PACE-2017-Instances/" + name;
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path + ".gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(path + ".td.csv", graph);
+    td.rootTree();
+    if (nice)
+        td.turnIntoNiceTreeDecomposition();
+
+    MinWeightedVertexCover solver{graph, td};
+    std::vector<double> fractions;
+    solver.setProgressCallback([&fractions](double fraction) { fractions.push_back(fraction); });
+    solver.solve(num_threads);
+
+    bool success = returnAndOutputOnFailure(true, std::is_sorted(fractions.begin(), fractions.end()));
+    success &= returnAndOutputOnFailure(1.0, fractions.back());
+    return success;
+}
+
+bool test_estimate_of_nice_tree_decomposition() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex001.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex001.td.csv", graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    MinWeightedVertexCover solver{graph, td};
+    const SolveEstimate estimate = solver.estimate();
+    solver.solve();
+
+    // Every node of a nice tree decomposition stores its own table only, except for the introduce chains of the leaves.
+    double table_entries = 0;
+    td.doSomethingPostOrder([&td, &table_entries](Node_Id n_id) {
+        table_entries += tableSize<2>(td.getNode(n_id).bag.size());
+    });
+
+    bool success = returnAndOutputOnFailure(solver.getPredictedPeakEntries(), estimate.peak_entries);
+    success &= returnAndOutputOnFailure(true, estimate.total_entries >= table_entries);
+    success &= returnAndOutputOnFailure(true, estimate.work >= estimate.total_entries);
+    success &= returnAndOutputOnFailure(true, estimate.peak_bytes > estimate.peak_entries * sizeof(Vertex_Cover_Weight));
+    return success;
+}
+
+// ex004 has bags of 487 vertices, whose tables have more entries than a size_t can count.
+template<DPProblem Problem>
+bool test_estimate_of_large_bags() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex004.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex004.td.csv", graph);
+    td.rootTree();
+    const FlatTreeDecomposition flat_td = FlatTreeDecomposition::nice(td);
+
+    TreeDecompositionDP<Problem> solver{graph, flat_td};
+    const SolveEstimate estimate = solver.estimate();
+    const double largest_table = std::pow(double(Problem::STATES), double(flat_td.getTreewidth() + 1));
+
+    bool success = returnAndOutputOnFailure(true, estimate.total_entries >= largest_table);
+    success &= returnAndOutputOnFailure(true, estimate.total_entries >= estimate.peak_entries);
+    success &= returnAndOutputOnFailure(true, estimate.work >= estimate.total_entries);
+    return success;
+}
+
+// On several threads, the peak is bounded by the entries of all tables, which the parallel solve may keep live at once.
+bool test_estimate_of_parallel_peak() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex009.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex009.td.csv", graph);
+    td.rootTree();
+    const FlatTreeDecomposition flat_td = FlatTreeDecomposition::nice(td);
+
+    MinWeightedVertexCover solver{graph, flat_td};
+    const SolveEstimate sequential = solver.estimate();
+    const SolveEstimate parallel = solver.estimate(4);
+
+    double table_entries = 0;
+    for (const Node_Id n_id : flat_td.getPreOrder())
+        table_entries += tableSize<2>(flat_td.getBag(n_id).size());
+
+    bool success = returnAndOutputOnFailure(sequential.total_entries, parallel.total_entries);
+    success &= returnAndOutputOnFailure(sequential.work, parallel.work);
+    success &= returnAndOutputOnFailure(table_entries, parallel.peak_entries);
+    success &= returnAndOutputOnFailure(true, parallel.peak_entries > sequential.peak_entries);
+    success &= returnAndOutputOnFailure(true, parallel.peak_bytes > sequential.peak_bytes);
+
+    solver.solve(4);
+    success &= returnAndOutputOnFailure(true, double(solver.getObservedPeakEntries()) <= parallel.peak_entries);
+    return success;
+}
+
+int test_solve_estimate(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_estimate_of_nice_tree_decomposition();
+    success &= test_estimate_of_large_bags<VertexCoverProblem>();
+    success &= test_estimate_of_large_bags<ThreeColoringProblem>();
+    success &= test_estimate_of_parallel_peak();
+    success &= test_progress_reaches_estimated_work("ex001", true, 1);
+    success &= test_progress_reaches_estimated_work("ex009", false, 1);
+    success &= test_progress_reaches_estimated_work("ex009", true, 2);
+
+    return !success;
+}
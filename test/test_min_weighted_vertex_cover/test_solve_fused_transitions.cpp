@@ -0,0 +1,53 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "util.h"
+
+using std::cout;
+using std::endl;
+
+bool solve_with_fused_transitions(const std::string& graph_path, const std::string& td_path, size_t num_threads) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+
+    TreeDecomposition nice_td = TreeDecomposition::parseUnsafe(td_path, graph);
+    nice_td.rootTree();
+    nice_td.turnIntoNiceTreeDecomposition();
+    MinWeightedVertexCover nice_solver{graph, nice_td};
+    Solution expected = nice_solver.solve();
+
+    // The tree decomposition as given, with arbitrary bag changes between adjacent nodes and arbitrarily many children.
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+    td.rootTree();
+    MinWeightedVertexCover solver{graph, td};
+    Solution got = solver.solve(num_threads);
+
+    bool success = returnAndOutputOnFailure(expected.total_weight, got.total_weight);
+    Vertex_Cover_Weight cover_weight = 0;
+    for (const Vertex_Id v_id : got.past_vertex_cover)
+        cover_weight += graph.getWeight(v_id);
+    success &= returnAndOutputOnFailure(got.total_weight, cover_weight);
+    for (const Edge& edge : graph.getEdges()) {
+        if (!contains(got.past_vertex_cover, edge.first) && !contains(got.past_vertex_cover, edge.second)) {
+            cout << "Edge " << edge << " is not covered." << endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+int test_solve_fused_transitions(int argc, char** argv) {
+    bool success = true;
+
+    std::vector<std::string>test_names{"cycle", "house", "k4_plus_2_appendages", "k4_plus_3_appendages", "k4_plus_4_appendages", "sigma_graph"};
+    for (const std::string& test_name : test_names) {
+        const std::string path = "test-instances/unit-test-instances/" + test_name;
+        success &= solve_with_fused_transitions(path + ".gr.csv", path + ".td.csv", 1);
+    }
+    for (const std::string instance : {"ex001", "ex007", "ex008"}) {
+        const std::string path = "test-instances/Treewidth-PACE-2017-Instances/" + instance;
+        success &= solve_with_fused_transitions(path + ".gr.csv", path + ".td.csv", 1);
+        success &= solve_with_fused_transitions(path + ".gr.csv", path + ".td.csv", 4);
+    }
+
+    return !success;
+}
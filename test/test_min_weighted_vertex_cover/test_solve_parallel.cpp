@@ -0,0 +1,95 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "thread_pool.h"
+#include "util.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using std::cout;
+using std::endl;
+
+bool solve_in_parallel(const std::string& graph_path, const std::string& td_path, size_t num_threads) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    MinWeightedVertexCover sequential_solver{graph, td};
+    Solution expected = sequential_solver.solve();
+
+    MinWeightedVertexCover parallel_solver{graph, td};
+    Solution got = parallel_solver.solve(num_threads);
+
+    bool success = returnAndOutputOnFailure(expected.total_weight, got.total_weight);
+    for (const Edge& edge : graph.getEdges()) {
+        if (!contains(got.past_vertex_cover, edge.first) && !contains(got.past_vertex_cover, edge.second)) {
+            cout << "Edge " << edge << " is not covered." << endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+// An exception thrown by a task reaches `wait`, and the pool keeps working afterwards.
+bool pool_rethrows_task_exception() {
+    WorkStealingThreadPool pool{4};
+    std::atomic<size_t> finished = 0;
+    pool.submit([]() { throw std::runtime_error("task failed"); });
+    for (size_t i = 0; i < 100; i++)
+        pool.submit([&finished]() { finished++; });
+    bool success = true;
+    try {
+        pool.wait();
+        success = false;
+    }
+    catch (const std::runtime_error&) {}
+
+    const size_t finished_before = finished;
+    for (size_t i = 0; i < 100; i++)
+        pool.submit([&finished]() { finished++; });
+    pool.wait();
+    success &= returnAndOutputOnFailure(finished_before + 100, size_t(finished));
+    return success;
+}
+
+// Spilling into a directory that does not exist throws in a worker, which has to reach the caller of `solve` as it does without threads.
+bool solve_in_parallel_rethrows() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex001.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex001.td.csv", graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    bool success = true;
+    for (const size_t num_threads : {1, 4}) {
+        MinWeightedVertexCover solver{graph, td};
+        SpillOptions spill_options;
+        spill_options.threshold_bytes = 1;
+        spill_options.directory = "/nonexistent";
+        solver.setSpillOptions(spill_options);
+        try {
+            solver.solve(num_threads);
+            success = false;
+        }
+        catch (const std::runtime_error&) {}
+    }
+    return success;
+}
+
+int test_solve_parallel(int argc, char** argv) {
+    bool success = true;
+
+    std::vector<std::string>test_names{"cycle", "house", "k4_plus_2_appendages", "k4_plus_3_appendages", "k4_plus_4_appendages", "sigma_graph"};
+    for (const std::string& test_name : test_names) {
+        const std::string path = "test-instances/unit-test-instances/" + test_name;
+        success &= solve_in_parallel(path + ".gr.csv", path + ".td.csv", 4);
+    }
+    const std::string path = "test-instances/Treewidth-PACE-2017-Instances/ex001";
+    for (size_t num_threads : {2, 3, 8})
+        success &= solve_in_parallel(path + ".gr.csv", path + ".td.csv", num_threads);
+    success &= pool_rethrows_task_exception();
+    success &= solve_in_parallel_rethrows();
+
+    return !success;
+}
@@ -0,0 +1,53 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "util.h"
+
+bool test_spillable_buffer() {
+    SpillOptions options;
+    options.threshold_bytes = 64;
+
+    SpillableBuffer<int> small;
+    small.allocate(4, options);
+    SpillableBuffer<int> large;
+    large.allocate(1000, options);
+
+    bool success = returnAndOutputOnFailure(false, small.isSpilled());
+    success &= returnAndOutputOnFailure(true, large.isSpilled());
+    for (size_t i = 0; i < large.size(); i++)
+        large[i] = i;
+    SpillableBuffer<int> moved = std::move(large);
+    success &= returnAndOutputOnFailure(999, moved[999]);
+    success &= returnAndOutputOnFailure((size_t)0, large.size());
+
+    return success;
+}
+
+bool test_solve_with_spilled_tables(const std::string& graph_path, const std::string& td_path) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+
+    MinWeightedVertexCover in_memory_solver{graph, td};
+    Solution expected = in_memory_solver.solve();
+
+    SpillOptions options;
+    options.threshold_bytes = 0;
+    MinWeightedVertexCover spilling_solver{graph, td};
+    spilling_solver.setSpillOptions(options);
+    Solution got = spilling_solver.solve();
+
+    return returnAndOutputOnFailure(expected.total_weight, got.total_weight) &&
+        returnAndOutputOnFailure(expected.past_vertex_cover.size(), got.past_vertex_cover.size());
+}
+
+int test_spill_to_disk(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_spillable_buffer();
+    success &= test_solve_with_spilled_tables("test-instances/unit-test-instances/house.gr.csv", "test-instances/unit-test-instances/house.td.csv");
+    success &= test_solve_with_spilled_tables("test-instances/Treewidth-PACE-2017-Instances/ex001.gr.csv", "test-instances/Treewidth-PACE-2017-Instances/ex001.td.csv");
+
+    return !success;
+}
@@ -0,0 +1,96 @@
+#include "table_arena.h"
+#include "util.h"
+
+bool test_buffers_are_reused_per_size() {
+    TableArena<Vertex_Cover_Weight> arena{2};
+    SpillOptions options;
+
+    auto buffer1 = arena.acquire(16, options);
+    auto buffer2 = arena.acquire(16, options);
+    auto buffer3 = arena.acquire(16, options);
+    const Vertex_Cover_Weight* data1 = buffer1.data();
+
+    arena.recycle(std::move(buffer1));
+    arena.recycle(std::move(buffer2));
+    arena.recycle(std::move(buffer3)); // exceeds the 2 free buffers per size and is freed
+
+    bool success = returnAndOutputOnFailure((size_t)0, buffer1.size());
+
+    auto other_size = arena.acquire(32, options);
+    success &= returnAndOutputOnFailure((size_t)32, other_size.size());
+    success &= returnAndOutputOnFailure((size_t)0, arena.numberOfReusedBuffers());
+
+    auto reused1 = arena.acquire(16, options);
+    auto reused2 = arena.acquire(16, options);
+    auto fresh = arena.acquire(16, options);
+    success &= returnAndOutputOnFailure((size_t)16, reused1.size());
+    success &= returnAndOutputOnFailure(true, reused1.data() == data1 || reused2.data() == data1);
+    success &= returnAndOutputOnFailure((size_t)2, arena.numberOfReusedBuffers());
+    success &= returnAndOutputOnFailure((size_t)7, arena.numberOfAcquiredBuffers());
+
+    return success;
+}
+
+// Tables of 3-coloring have 3^k entries, which differ from the sizes of the same bit width that come after them.
+bool test_buffers_of_other_sizes_are_kept() {
+    TableArena<uint64_t> arena;
+    SpillOptions options;
+
+    auto buffer = arena.acquire(27, options);
+    const uint64_t* data = buffer.data();
+    arena.recycle(std::move(buffer));
+
+    auto other_size = arena.acquire(30, options);
+    bool success = returnAndOutputOnFailure((size_t)30, other_size.size());
+    auto reused = arena.acquire(27, options);
+    success &= returnAndOutputOnFailure(true, reused.data() == data);
+    success &= returnAndOutputOnFailure((size_t)1, arena.numberOfReusedBuffers());
+    return success;
+}
+
+bool test_buffers_keep_their_backing() {
+    TableArena<Vertex_Cover_Weight> arena;
+    SpillOptions heap_options;
+    SpillOptions spill_options;
+    spill_options.threshold_bytes = 1;
+
+    auto heap_buffer = arena.acquire(16, heap_options);
+    const Vertex_Cover_Weight* heap_data = heap_buffer.data();
+    arena.recycle(std::move(heap_buffer));
+
+    auto spilled = arena.acquire(16, spill_options);
+    bool success = returnAndOutputOnFailure(true, spilled.isSpilled());
+    success &= returnAndOutputOnFailure((size_t)0, arena.numberOfReusedBuffers());
+    arena.recycle(std::move(spilled));
+
+    auto reused = arena.acquire(16, heap_options);
+    success &= returnAndOutputOnFailure(false, reused.isSpilled());
+    success &= returnAndOutputOnFailure(true, reused.data() == heap_data);
+    auto reused_spilled = arena.acquire(16, spill_options);
+    success &= returnAndOutputOnFailure(true, reused_spilled.isSpilled());
+    success &= returnAndOutputOnFailure((size_t)2, arena.numberOfReusedBuffers());
+    return success;
+}
+
+bool test_huge_pages() {
+    SpillOptions options;
+    options.use_huge_pages = true;
+
+    SpillableBuffer<Vertex_Cover_Weight> buffer;
+    buffer.allocate(HUGE_PAGE_BYTES / sizeof(Vertex_Cover_Weight), options);
+    for (size_t i = 0; i < buffer.size(); i++)
+        buffer[i] = i;
+
+    return returnAndOutputOnFailure((Vertex_Cover_Weight)(buffer.size() - 1), buffer[buffer.size() - 1]);
+}
+
+int test_table_arena(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_buffers_are_reused_per_size();
+    success &= test_buffers_of_other_sizes_are_kept();
+    success &= test_buffers_keep_their_backing();
+    success &= test_huge_pages();
+
+    return !success;
+}
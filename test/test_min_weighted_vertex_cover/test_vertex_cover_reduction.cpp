@@ -0,0 +1,58 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "vertex_cover_reduction.h"
+#include "util.h"
+
+using std::cout;
+using std::endl;
+
+bool test_reduce_and_lift(const std::string& graph_path, const std::string& td_path) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(graph_path);
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(td_path, graph);
+
+    VertexCoverReduction reduction{graph};
+    TreeDecomposition reduced_td = reduction.reduceTreeDecomposition(td);
+    bool success = returnAndOutputOnFailure(true, reduced_td.isValid());
+    success &= returnAndOutputOnFailure(true, reduced_td.getTreewidth() <= td.getTreewidth());
+    success &= returnAndOutputOnFailure(graph.numberOfNodes() - reduction.numberOfRemovedVertices(), reduction.getReducedGraph().numberOfNodes());
+
+    td.rootTree();
+    td.turnIntoNiceTreeDecomposition();
+    MinWeightedVertexCover solver{graph, td};
+    const Solution expected = solver.solve();
+
+    reduced_td.rootTree();
+    reduced_td.turnIntoNiceTreeDecomposition();
+    MinWeightedVertexCover reduced_solver{reduction.getReducedGraph(), reduced_td};
+    const Solution got = reduction.lift(reduced_solver.solve());
+
+    success &= returnAndOutputOnFailure(expected.total_weight, got.total_weight);
+    Vertex_Cover_Weight cover_weight = 0;
+    for (const Vertex_Id v_id : got.past_vertex_cover)
+        cover_weight += graph.getWeight(v_id);
+    success &= returnAndOutputOnFailure(got.total_weight, cover_weight);
+    for (const Edge& edge : graph.getEdges()) {
+        if (!contains(got.past_vertex_cover, edge.first) && !contains(got.past_vertex_cover, edge.second)) {
+            cout << "Edge " << edge << " is not covered." << endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+int test_vertex_cover_reduction(int argc, char** argv) {
+    bool success = true;
+
+    std::vector<std::string>test_names{"cycle", "house", "k4_plus_2_appendages", "k4_plus_3_appendages", "k4_plus_4_appendages", "sigma_graph"};
+    for (const std::string& test_name : test_names) {
+        const std::string path = "test-instances/unit-test-instances/" + test_name;
+        success &= test_reduce_and_lift(path + ".gr.csv", path + ".td.csv");
+    }
+    for (const std::string instance : {"ex001", "ex005", "ex009", "ex012"}) {
+        const std::string path = "test-instances/Treewidth-PACE-2017-Instances/" + instance;
+        success &= test_reduce_and_lift(path + ".gr.csv", path + ".td.csv");
+    }
+
+    return !success;
+}
@@ -0,0 +1,89 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "elimination_ordering.h"
+#include "min_weighted_vertex_cover.h"
+#include "util.h"
+
+#include <algorithm>
+
+const std::vector<EliminationHeuristic> heuristics{EliminationHeuristic::MinDegree, EliminationHeuristic::MinFill};
+
+bool test_elimination_ordering_is_permutation() {
+    bool success = true;
+    for (const std::string name : {"cycle", "house", "k4_plus_3_appendages", "k5", "sigma_graph"}) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/" + name + ".gr.csv");
+        for (const EliminationHeuristic heuristic : heuristics) {
+            std::vector<Vertex_Id> ordering = computeEliminationOrdering(graph, heuristic);
+            std::vector<Vertex_Id> vertices = graph.getVertices();
+            std::sort(ordering.begin(), ordering.end());
+            std::sort(vertices.begin(), vertices.end());
+            success &= returnAndOutputOnFailure(vertices, ordering);
+        }
+    }
+    return success;
+}
+
+bool test_elimination_ordering_treewidth() {
+    std::vector<std::pair<std::string, size_t>> tests{
+        {"cycle", 2},
+        {"house", 2},
+        {"k4_plus_2_appendages", 3},
+        {"k4_plus_4_appendages", 3},
+        {"k5", 4}
+    };
+    bool success = true;
+    for (const auto& [name, treewidth] : tests) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/" + name + ".gr.csv");
+        for (const EliminationHeuristic heuristic : heuristics) {
+            TreeDecomposition td = TreeDecomposition::fromEliminationOrdering(graph, computeEliminationOrdering(graph, heuristic));
+            success &= returnAndOutputOnFailure(true, td.isValid());
+            success &= returnAndOutputOnFailure(treewidth, td.getTreewidth());
+        }
+    }
+    return success;
+}
+
+bool test_elimination_ordering_large_graphs() {
+    bool success = true;
+    for (const std::string name : {"ex001", "ex005", "ex009"}) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".gr.csv");
+        TreeDecomposition given_td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".td.csv", graph);
+        given_td.rootTree();
+        given_td.turnIntoNiceTreeDecomposition();
+        const Vertex_Cover_Weight expected_weight = MinWeightedVertexCover{graph, given_td}.solve().total_weight;
+
+        for (const EliminationHeuristic heuristic : heuristics) {
+            TreeDecomposition td = TreeDecomposition::fromEliminationOrdering(graph, computeEliminationOrdering(graph, heuristic));
+            success &= returnAndOutputOnFailure(true, td.isValid());
+
+            td.rootTree();
+            td.turnIntoNiceTreeDecomposition();
+            success &= returnAndOutputOnFailure(expected_weight, MinWeightedVertexCover{graph, td}.solve().total_weight);
+        }
+    }
+    return success;
+}
+
+bool test_elimination_ordering_invalid_ordering() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
+    std::vector<Vertex_Id> ordering = graph.getVertices();
+    ordering.back() = ordering.front();
+    try {
+        TreeDecomposition::fromEliminationOrdering(graph, ordering);
+    }
+    catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+int test_elimination_ordering(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_elimination_ordering_is_permutation();
+    success &= test_elimination_ordering_treewidth();
+    success &= test_elimination_ordering_large_graphs();
+    success &= test_elimination_ordering_invalid_ordering();
+
+    return !success;
+}
@@ -0,0 +1,84 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "util.h"
+
+#include <cmath>
+
+// Sums the entries of all nodes of the nice tree decomposition rooted at `root_id` and separately those of its join nodes.
+std::pair<double, double> niceEntries(TreeDecomposition td, Node_Id root_id) {
+    td.rootTree(root_id);
+    td.turnIntoNiceTreeDecomposition();
+    double entries = 0;
+    double join_entries = 0;
+    td.doSomethingPostOrder([&td, &entries, &join_entries](Node_Id n_id) {
+        const Node& node = td.getNode(n_id);
+        entries += std::pow(2.0, node.bag.size());
+        if (node.children.size() == 2)
+            join_entries += std::pow(2.0, node.bag.size());
+    });
+    return {entries, join_entries};
+}
+
+bool test_estimate_root_costs_matches_nice_tree_decomposition() {
+    bool success = true;
+    for (const std::string name : {"cycle", "house", "k4_plus_2_appendages", "k4_plus_4_appendages", "sigma_graph"}) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/" + name + ".gr.csv");
+        TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/" + name + ".td.csv", graph);
+
+        const std::unordered_map<Node_Id, double> costs = td.estimateRootCosts({2, 0.5, 0});
+        for (const std::string& node_name : td.getAllNodeNames()) {
+            const Node_Id root_id = td.nameToId(node_name);
+            const auto [entries, join_entries] = niceEntries(td, root_id);
+            success &= returnAndOutputOnFailure(entries + 0.5 * join_entries, costs.at(root_id));
+        }
+    }
+    return success;
+}
+
+bool test_estimate_root_costs_peak() {
+    // The peak of the estimate is the peak of the memory-aware post-order over the original nodes.
+    bool success = true;
+    for (const std::string name : {"ex001", "ex005"}) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".gr.csv");
+        TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".td.csv", graph);
+
+        const std::unordered_map<Node_Id, double> costs_without_peak = td.estimateRootCosts({2, 1, 0});
+        const std::unordered_map<Node_Id, double> costs = td.estimateRootCosts({2, 1, 1});
+        const std::vector<std::string> node_names = td.getAllNodeNames();
+        for (size_t i = 0; i < node_names.size(); i += 7) {
+            const Node_Id root_id = td.nameToId(node_names[i]);
+            td.rootTree(root_id);
+            double predicted_peak_entries = 0;
+            MinWeightedVertexCover{graph, td}.memoryAwarePostOrder(predicted_peak_entries);
+            success &= returnAndOutputOnFailure(predicted_peak_entries, costs.at(root_id) - costs_without_peak.at(root_id));
+        }
+    }
+    return success;
+}
+
+bool test_estimate_root_costs_root_tree() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex009.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex009.td.csv", graph);
+
+    const std::unordered_map<Node_Id, double> costs = td.estimateRootCosts({});
+    const Node_Id root_id = td.rootTree(RootSelection::MinimumCost);
+
+    bool success = td.isRooted() && td.getRoot() == root_id;
+    for (const auto& [n_id, cost] : costs)
+        success &= costs.at(root_id) <= cost;
+
+    td.turnIntoNiceTreeDecomposition();
+    success &= returnAndOutputOnFailure(true, td.isValid());
+    return success;
+}
+
+int test_estimate_root_costs(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_estimate_root_costs_matches_nice_tree_decomposition();
+    success &= test_estimate_root_costs_peak();
+    success &= test_estimate_root_costs_root_tree();
+
+    return !success;
+}
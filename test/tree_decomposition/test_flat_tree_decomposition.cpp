@@ -0,0 +1,122 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "flat_tree_decomposition.h"
+#include "util.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+bool test_flat_tree_decomposition_matches(const std::string& path) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path + ".gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe(path + ".td.csv", graph);
+    td.rootTree();
+    bool success = returnAndOutputOnFailure(td.isNiceTreeDecomposition(), FlatTreeDecomposition{td}.isNice());
+    td.turnIntoNiceTreeDecomposition();
+    const FlatTreeDecomposition flat_td{td};
+    success &= returnAndOutputOnFailure(true, flat_td.isNice());
+
+    success &= returnAndOutputOnFailure(td.getRoot(), flat_td.getRoot());
+    success &= returnAndOutputOnFailure(td.getAllNodeNames().size(), flat_td.numberOfNodes());
+    success &= returnAndOutputOnFailure(td.getTreewidth(), flat_td.getTreewidth());
+    success &= returnAndOutputOnFailure(std::optional<Node_Id>{}, flat_td.getParent(flat_td.getRoot()));
+
+    std::vector<bool> visited(flat_td.idBound(), false);
+    for (const Node_Id n_id : flat_td.getPreOrder()) {
+        const Node& node = td.getNode(n_id);
+        const std::optional<Node_Id> parent = flat_td.getParent(n_id);
+        // Every node comes after its parent.
+        success &= returnAndOutputOnFailure(true, !parent.has_value() || visited[parent.value()]);
+        visited[n_id] = true;
+
+        const std::span<const Vertex_Id> bag = flat_td.getBag(n_id);
+        success &= returnAndOutputOnFailure(true, std::is_sorted(bag.begin(), bag.end()));
+        success &= returnAndOutputOnFailure(node.bag, Bag{bag.begin(), bag.end()});
+
+        const std::span<const Node_Id> children = flat_td.getChildren(n_id);
+        success &= returnAndOutputOnFailure(node.children, std::unordered_set<Node_Id>{children.begin(), children.end()});
+        for (const Node_Id child_id : children)
+            success &= returnAndOutputOnFailure(std::optional{n_id}, flat_td.getParent(child_id));
+    }
+    return success;
+}
+
+// Checks that every node is a leaf, an introduce, forget or join node, and that the size matches the nice `TreeDecomposition` built the other way.
+bool test_flat_tree_decomposition_nice(const std::string& path) {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path + ".gr.csv");
+    bool success = true;
+    for (const JoinTreeShape shape : {JoinTreeShape::Caterpillar, JoinTreeShape::Balanced, JoinTreeShape::Weighted}) {
+        TreeDecomposition td = TreeDecomposition::parseUnsafe(path + ".td.csv", graph);
+        td.rootTree();
+        const FlatTreeDecomposition flat_td = FlatTreeDecomposition::nice(td, shape);
+        td.turnIntoNiceTreeDecomposition(shape);
+
+        success &= returnAndOutputOnFailure(td.getAllNodeNames().size(), flat_td.numberOfNodes());
+        success &= returnAndOutputOnFailure(td.getTreewidth(), flat_td.getTreewidth());
+        success &= returnAndOutputOnFailure(flat_td.numberOfNodes(), flat_td.idBound());
+        success &= returnAndOutputOnFailure(true, flat_td.isNice());
+        success &= returnAndOutputOnFailure(std::optional<Node_Id>{}, flat_td.getParent(flat_td.getRoot()));
+
+        std::vector<bool> visited(flat_td.idBound(), false);
+        for (const Node_Id n_id : flat_td.getPreOrder()) {
+            const std::optional<Node_Id> parent = flat_td.getParent(n_id);
+            success &= returnAndOutputOnFailure(true, !parent.has_value() || visited[parent.value()]);
+            visited[n_id] = true;
+
+            const std::span<const Vertex_Id> bag = flat_td.getBag(n_id);
+            const std::span<const Node_Id> children = flat_td.getChildren(n_id);
+            success &= returnAndOutputOnFailure(true, std::is_sorted(bag.begin(), bag.end()));
+            if (children.empty()) {
+                success &= returnAndOutputOnFailure(true, bag.size() <= 1);
+            }
+            else if (children.size() == 1) {
+                const std::span<const Vertex_Id> child_bag = flat_td.getBag(children[0]);
+                const bool is_introduce = bag.size() == child_bag.size() + 1 && std::includes(bag.begin(), bag.end(), child_bag.begin(), child_bag.end());
+                const bool is_forget = child_bag.size() == bag.size() + 1 && std::includes(child_bag.begin(), child_bag.end(), bag.begin(), bag.end());
+                success &= returnAndOutputOnFailure(true, is_introduce || is_forget);
+            }
+            else {
+                success &= returnAndOutputOnFailure(size_t{2}, children.size());
+                for (const Node_Id child_id : children)
+                    success &= returnAndOutputOnFailure(true, std::ranges::equal(bag, flat_td.getBag(child_id)));
+            }
+        }
+    }
+    return success;
+}
+
+bool test_flat_tree_decomposition_unrooted() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/cycle.td.csv", graph);
+    try {
+        FlatTreeDecomposition flat_td{td};
+        return false;
+    }
+    catch (const std::invalid_argument&) {
+        return true;
+    }
+}
+
+bool test_flat_tree_decomposition_nice_unrooted() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/cycle.td.csv", graph);
+    try {
+        FlatTreeDecomposition::nice(td);
+        return false;
+    }
+    catch (const std::invalid_argument&) {
+        return true;
+    }
+}
+
+int test_flat_tree_decomposition(int argc, char** argv) {
+    bool success = true;
+    for (const std::string test_name : {"cycle", "house", "k4_plus_4_appendages", "sigma_graph"}) {
+        success &= test_flat_tree_decomposition_matches("test-instances/unit-test-instances/" + test_name);
+        success &= test_flat_tree_decomposition_nice("test-instances/unit-test-instances/" + test_name);
+    }
+    success &= test_flat_tree_decomposition_matches("test-instances/Treewidth-PACE-2017-Instances/ex009");
+    success &= test_flat_tree_decomposition_nice("test-instances/Treewidth-PACE-2017-Instances/ex009");
+    success &= test_flat_tree_decomposition_unrooted();
+    success &= test_flat_tree_decomposition_nice_unrooted();
+    return !success;
+}
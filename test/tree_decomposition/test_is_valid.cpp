@@ -38,6 +38,14 @@ bool test_is_valid_subtree_disconnected() {
     return !td.isValid();
 }
 
+bool test_is_valid_cyclic() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/cycle_cyclic.td.csv", graph);
+
+    // All three properties hold, but the nodes form a cycle.
+    return !td.isValid();
+}
+
 bool test_is_valid_large_graphs() {
     const std::filesystem::path large_instances_path{"test-instances/Treewidth-PACE-2017-Instances"};
     std::vector<std::pair<std::string,std::string>> graph_td_files_pairs;
@@ -72,7 +80,8 @@ int test_is_valid(int argc, char** argv) {
     success &= test_is_valid_vertex_missing();
     success &= test_is_valid_edge_missing();
     success &= test_is_valid_subtree_disconnected();
-    // success &= test_is_valid_large_graphs(); // this takes a long time (3 seconds total, but still.)
+    success &= test_is_valid_cyclic();
+    success &= test_is_valid_large_graphs();
 
     return !success;
 }
\ No newline at end of file
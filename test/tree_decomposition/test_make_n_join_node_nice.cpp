@@ -2,11 +2,13 @@
 #include "util.h"
 
 #include <cassert>
+#include <filesystem>
+#include <fstream>
 
 using std::cout;
 using std::endl;
 
-int test_make_n_join_node_nice(int argc, char** argv) {
+bool test_make_n_join_node_nice_appendages() {
     bool success = true;
     for (int appendages = 2; appendages <= 4; appendages++) {
         UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/k4_plus_" + std::to_string(appendages) + "_appendages.gr.csv");
@@ -25,5 +27,79 @@ int test_make_n_join_node_nice(int argc, char** argv) {
             break;
     }
 
+    return success;
+}
+
+size_t depth(const TreeDecomposition& td, Node_Id n_id) {
+    size_t depth = 0;
+    for (std::optional<Node_Id> parent = td.getNode(n_id).parent; parent.has_value(); parent = td.getNode(parent.value()).parent)
+        depth++;
+    return depth;
+}
+
+// A star with c leaves, whose tree decomposition is the bag {0} with c children {0, i}, so that making it nice only adds join nodes.
+bool test_make_n_join_node_nice_shapes() {
+    constexpr size_t c = 37;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    {
+        std::ofstream graph_file{directory / "test_make_n_join_node_nice.gr.csv"};
+        std::ofstream td_file{directory / "test_make_n_join_node_nice.td.csv"};
+        for (size_t i = 1; i <= c; i++) {
+            graph_file << 0 << "," << i << "\n";
+            td_file << "N0,N" << i << "\n";
+        }
+        td_file << "N0,,0\n";
+        for (size_t i = 1; i <= c; i++)
+            td_file << "N" << i << ",,0;" << i << "\n";
+    }
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(directory / "test_make_n_join_node_nice.gr.csv");
+
+    bool success = true;
+    for (const JoinTreeShape shape : {JoinTreeShape::Caterpillar, JoinTreeShape::Balanced, JoinTreeShape::Weighted}) {
+        TreeDecomposition td = TreeDecomposition::parseUnsafe(directory / "test_make_n_join_node_nice.td.csv", graph);
+        td.rootTree(td.nameToId("N0"));
+        // The first child is by far the most expensive.
+        const std::unordered_map<Node_Id, double> subtree_costs{{td.nameToId("N1"), 1000.0}};
+        td.makeNJoinNodeNice(td.nameToId("N0"), shape, subtree_costs);
+
+        success &= returnAndOutputOnFailure(true, td.isValid());
+        success &= returnAndOutputOnFailure(true, td.isNiceTreeDecomposition());
+        success &= returnAndOutputOnFailure(1 + c + 2 * (c - 1), td.getAllNodeNames().size());
+
+        size_t max_depth = 0;
+        for (size_t i = 1; i <= c; i++)
+            max_depth = std::max(max_depth, depth(td, td.nameToId("N" + std::to_string(i))));
+        // The children hang below the leaves of the join tree.
+        if (shape == JoinTreeShape::Caterpillar)
+            success &= returnAndOutputOnFailure(c, max_depth);
+        else if (shape == JoinTreeShape::Balanced)
+            success &= returnAndOutputOnFailure(size_t{7}, max_depth);
+        else
+            success &= returnAndOutputOnFailure(size_t{2}, depth(td, td.nameToId("N1")));
+    }
+    std::filesystem::remove(directory / "test_make_n_join_node_nice.gr.csv");
+    std::filesystem::remove(directory / "test_make_n_join_node_nice.td.csv");
+    return success;
+}
+
+bool test_make_n_join_node_nice_unit_instances() {
+    bool success = true;
+    for (const std::string test_name : {"cycle", "house", "k4_plus_4_appendages", "sigma_graph"}) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/" + test_name + ".gr.csv");
+        for (const JoinTreeShape shape : {JoinTreeShape::Balanced, JoinTreeShape::Weighted}) {
+            TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/" + test_name + ".td.csv", graph);
+            td.rootTree();
+            td.turnIntoNiceTreeDecomposition(shape);
+            success &= returnAndOutputOnFailure(true, td.isValid());
+            success &= returnAndOutputOnFailure(true, td.isNiceTreeDecomposition());
+        }
+    }
+    return success;
+}
+
+int test_make_n_join_node_nice(int argc, char** argv) {
+    bool success = test_make_n_join_node_nice_appendages();
+    success &= test_make_n_join_node_nice_shapes();
+    success &= test_make_n_join_node_nice_unit_instances();
     return !success;
 }
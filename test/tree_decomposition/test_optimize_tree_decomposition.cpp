@@ -0,0 +1,80 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "tree_decomposition_optimizer.h"
+#include "min_weighted_vertex_cover.h"
+#include "util.h"
+
+#include <algorithm>
+
+bool test_optimize_tree_decomposition_elimination_ordering_of() {
+    // The ordering of a tree decomposition induces a tree decomposition that is not wider.
+    bool success = true;
+    for (const std::string name : {"ex001", "ex005", "ex009"}) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".gr.csv");
+        TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".td.csv", graph);
+
+        std::vector<Vertex_Id> ordering = eliminationOrderingOf(graph, td);
+        TreeDecomposition induced_td = TreeDecomposition::fromEliminationOrdering(graph, ordering);
+        success &= returnAndOutputOnFailure(true, induced_td.isValid());
+        success &= returnAndOutputOnFailure(true, induced_td.getTreewidth() <= td.getTreewidth());
+
+        std::sort(ordering.begin(), ordering.end());
+        std::vector<Vertex_Id> vertices = graph.getVertices();
+        std::sort(vertices.begin(), vertices.end());
+        success &= returnAndOutputOnFailure(vertices, ordering);
+    }
+    return success;
+}
+
+bool test_optimize_tree_decomposition_reduces_cost() {
+    bool success = true;
+    OptimizerOptions options;
+    options.time_budget = std::chrono::milliseconds{200};
+    for (const std::string name : {"ex001", "ex005", "ex009"}) {
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".gr.csv");
+        TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/" + name + ".td.csv", graph);
+
+        TreeDecomposition optimized_td = optimizeTreeDecomposition(graph, td, options);
+        success &= returnAndOutputOnFailure(true, optimized_td.isValid());
+        success &= returnAndOutputOnFailure(true, decompositionCost(optimized_td, options.cost_model) <= decompositionCost(td, options.cost_model));
+
+        td.rootTree();
+        td.turnIntoNiceTreeDecomposition();
+        optimized_td.rootTree();
+        optimized_td.turnIntoNiceTreeDecomposition();
+        success &= returnAndOutputOnFailure(MinWeightedVertexCover{graph, td}.solve().total_weight, MinWeightedVertexCover{graph, optimized_td}.solve().total_weight);
+    }
+    return success;
+}
+
+bool test_optimize_tree_decomposition_cost_model() {
+    bool success = true;
+    DecompositionCostModel model;
+
+    // A root with a bag of 4 vertices and two children with bags of 2: Both children are live while the root is computed, the peak is 4 + 4 + 16.
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/k4_plus_2_appendages.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/k4_plus_2_appendages.td.csv", graph);
+    success &= returnAndOutputOnFailure(24.0 + 24.0, decompositionCost(td, model));
+
+    // A path of four bags of 3 vertices rooted at an end: Only a single child is live at once, the peak is 8 + 8.
+    graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
+    td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/cycle.td.csv", graph);
+    td.rootTree(td.nameToId("N1"));
+    success &= returnAndOutputOnFailure(32.0 + 16.0, decompositionCost(td, model));
+
+    // Rooted in the middle, the child with the longer path is computed first and stays live while the other one is computed.
+    td.rootTree(td.nameToId("N2"));
+    model.peak_weight = 2.0;
+    success &= returnAndOutputOnFailure(32.0 + 2.0 * 24.0, decompositionCost(td, model));
+    return success;
+}
+
+int test_optimize_tree_decomposition(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_optimize_tree_decomposition_elimination_ordering_of();
+    success &= test_optimize_tree_decomposition_reduces_cost();
+    success &= test_optimize_tree_decomposition_cost_model();
+
+    return !success;
+}
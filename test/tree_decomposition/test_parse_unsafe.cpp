@@ -1,7 +1,10 @@
 #include "undirected_graph.h"
 #include "tree_decomposition.h"
 #include "util.h"
+
 #include <cassert>
+#include <filesystem>
+#include <fstream>
 
 bool test_parse_unsafe_1() {
     UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
@@ -30,8 +33,72 @@ bool test_parse_unsafe_1() {
     return success;
 }
 
+bool test_parse_unsafe_pace() {
+    // The PACE files and the CSV files converted from them describe the same tree decompositions.
+    bool success = true;
+    for (const std::string name : {"ex001", "ex009"}) {
+        const std::string path = "test-instances/Treewidth-PACE-2017-Instances/" + name;
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe(path + ".gr");
+        TreeDecomposition pace_td = TreeDecomposition::parseUnsafe(path + ".td", graph);
+        TreeDecomposition csv_td = TreeDecomposition::parseUnsafe(path + ".td.csv", graph);
+
+        success &= returnAndOutputOnFailure(true, pace_td.isValid());
+        std::vector<std::string> node_names = pace_td.getAllNodeNames();
+        std::vector<std::string> csv_node_names = csv_td.getAllNodeNames();
+        success &= returnAndOutputOnFailure(true, setEqual(node_names, csv_node_names));
+        for (const std::string& n_name : node_names) {
+            const Node& pace_node = pace_td.getNode(pace_td.nameToId(n_name));
+            const Node& csv_node = csv_td.getNode(csv_td.nameToId(n_name));
+            success &= returnAndOutputOnFailure(csv_node.bag, pace_node.bag);
+            for (const Node_Id neighbour_id : csv_node.neighbours)
+                success &= pace_td.areNeighbours(pace_td.nameToId(n_name), pace_td.nameToId(csv_td.getNode(neighbour_id).name));
+            success &= returnAndOutputOnFailure(csv_node.neighbours.size(), pace_node.neighbours.size());
+        }
+    }
+    return success;
+}
+
+bool test_parse_unsafe_pace_malformed() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    {
+        std::ofstream file{directory / "test_parse_unsafe_pace_malformed.gr"};
+        file << "p tw 3 2\n1 2\n2 3\n";
+    }
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(directory / "test_parse_unsafe_pace_malformed.gr");
+    std::filesystem::remove(directory / "test_parse_unsafe_pace_malformed.gr");
+
+    auto parses = [&directory, &graph](const std::string& contents) {
+        const std::filesystem::path path = directory / "test_parse_unsafe_pace_malformed.td";
+        {
+            std::ofstream file{path};
+            file << contents;
+        }
+        bool parsed = true;
+        try {
+            TreeDecomposition::parseUnsafe(path, graph);
+        }
+        catch (const std::invalid_argument&) {
+            parsed = false;
+        }
+        std::filesystem::remove(path);
+        return parsed;
+    };
+
+    bool success = returnAndOutputOnFailure(true, parses("s td 2 2 3\nb 1 1 2\nb 2 2 3\n1 2\n"));
+    // A bag without an index, bag and edge indices outside 1, ..., b, and a bag larger than the width in the header.
+    success &= returnAndOutputOnFailure(false, parses("s td 2 2 3\nb\nb 1 1 2\nb 2 2 3\n1 2\n"));
+    success &= returnAndOutputOnFailure(false, parses("s td 2 2 3\nb 1 1 2\nb 3 2 3\n1 2\n"));
+    success &= returnAndOutputOnFailure(false, parses("s td 2 2 3\nb 0 1 2\nb 2 2 3\n1 2\n"));
+    success &= returnAndOutputOnFailure(false, parses("s td 2 2 3\nb 1 1 2\nb 2 2 3\n1 3\n"));
+    success &= returnAndOutputOnFailure(false, parses("s td 2 2 3\nb 1 1 2\nb 2 2 3\n1 x\n"));
+    success &= returnAndOutputOnFailure(false, parses("s td 2 2 3\nb 1 1 2 3\nb 2 2 3\n1 2\n"));
+    return success;
+}
+
 int test_parse_unsafe(int argc, char** argv) {
     bool success = test_parse_unsafe_1();
+    success &= test_parse_unsafe_pace();
+    success &= test_parse_unsafe_pace_malformed();
 
     return !success;
 }
\ No newline at end of file
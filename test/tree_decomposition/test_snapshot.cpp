@@ -0,0 +1,133 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "flat_tree_decomposition.h"
+#include "min_weighted_vertex_cover.h"
+#include "snapshot.h"
+#include "util.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+bool test_snapshot_round_trip() {
+    bool success = true;
+    const std::string snapshot_path = (std::filesystem::temp_directory_path() / "test_snapshot_round_trip.snap").string();
+    for (const std::string name : {"ex001", "ex009"}) {
+        const std::string path = "test-instances/Treewidth-PACE-2017-Instances/" + name;
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe(path + ".gr.csv");
+        TreeDecomposition td = TreeDecomposition::parseUnsafe(path + ".td.csv", graph);
+        td.rootTree();
+        const FlatTreeDecomposition flat_td = FlatTreeDecomposition::nice(td);
+        Snapshot::save(snapshot_path, graph, flat_td);
+
+        const Snapshot snapshot(snapshot_path);
+        success &= returnAndOutputOnFailure(true, snapshot.isNice());
+
+        const UndirectedGraph loaded_graph = snapshot.graph();
+        success &= returnAndOutputOnFailure(graph.getVertices(), loaded_graph.getVertices());
+        success &= returnAndOutputOnFailure(graph.getEdges(), loaded_graph.getEdges());
+        for (const Vertex_Id v_id : graph.getVertices()) {
+            success &= returnAndOutputOnFailure(graph.idToName(v_id), loaded_graph.idToName(v_id));
+            success &= returnAndOutputOnFailure(v_id, loaded_graph.nameToId(graph.idToName(v_id)));
+            success &= returnAndOutputOnFailure(graph.getWeight(v_id), loaded_graph.getWeight(v_id));
+            success &= returnAndOutputOnFailure(true, std::ranges::equal(graph.getNeighbours(v_id), loaded_graph.getNeighbours(v_id)));
+        }
+
+        // The loaded nodes are numbered in the pre-order of the saved ones.
+        const FlatTreeDecomposition loaded_td = snapshot.flatTreeDecomposition();
+        success &= returnAndOutputOnFailure(flat_td.numberOfNodes(), loaded_td.numberOfNodes());
+        success &= returnAndOutputOnFailure(Node_Id{0}, loaded_td.getRoot());
+        const std::vector<Node_Id>& pre_order = flat_td.getPreOrder();
+        std::vector<Node_Id> number(flat_td.idBound());
+        for (size_t i = 0; i < pre_order.size(); i++) {
+            number[pre_order[i]] = i;
+            success &= returnAndOutputOnFailure(i, loaded_td.getPreOrder()[i]);
+            success &= returnAndOutputOnFailure(true, std::ranges::equal(flat_td.getBag(pre_order[i]), loaded_td.getBag(i)));
+            const std::optional<Node_Id> parent = flat_td.getParent(pre_order[i]);
+            success &= returnAndOutputOnFailure(parent.has_value() ? std::optional{number[parent.value()]} : std::nullopt, loaded_td.getParent(i));
+        }
+
+        MinWeightedVertexCover solver{graph, flat_td};
+        MinWeightedVertexCover loaded_solver{loaded_graph, loaded_td};
+        success &= returnAndOutputOnFailure(solver.solve().total_weight, loaded_solver.solve().total_weight);
+    }
+    std::filesystem::remove(snapshot_path);
+    return success;
+}
+
+// A tree decomposition saved for fused transitions can still be made nice after loading.
+bool test_snapshot_not_nice() {
+    bool success = true;
+    const std::string snapshot_path = (std::filesystem::temp_directory_path() / "test_snapshot_not_nice.snap").string();
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex009.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/Treewidth-PACE-2017-Instances/ex009.td.csv", graph);
+    td.rootTree();
+    Snapshot::save(snapshot_path, graph, FlatTreeDecomposition{td});
+
+    const Snapshot snapshot(snapshot_path);
+    success &= returnAndOutputOnFailure(false, snapshot.isNice());
+    const UndirectedGraph loaded_graph = snapshot.graph();
+    const TreeDecomposition loaded_td = snapshot.treeDecomposition(loaded_graph);
+    success &= returnAndOutputOnFailure(true, loaded_td.isValid());
+    success &= returnAndOutputOnFailure(td.getAllNodeNames().size(), loaded_td.getAllNodeNames().size());
+    success &= returnAndOutputOnFailure(td.getTreewidth(), loaded_td.getTreewidth());
+
+    const FlatTreeDecomposition nice_td = FlatTreeDecomposition::nice(td);
+    const FlatTreeDecomposition loaded_nice_td = FlatTreeDecomposition::nice(loaded_td);
+    MinWeightedVertexCover solver{graph, nice_td};
+    MinWeightedVertexCover loaded_solver{loaded_graph, loaded_nice_td};
+    success &= returnAndOutputOnFailure(solver.solve().total_weight, loaded_solver.solve().total_weight);
+    std::filesystem::remove(snapshot_path);
+    return success;
+}
+
+bool test_snapshot_invalid() {
+    bool success = true;
+    const std::string snapshot_path = (std::filesystem::temp_directory_path() / "test_snapshot_invalid.snap").string();
+    auto expectInvalid = [&success, &snapshot_path]() {
+        try {
+            Snapshot snapshot(snapshot_path);
+            success = false;
+        }
+        catch (const std::invalid_argument&) {}
+    };
+
+    // Not a snapshot at all.
+    std::ofstream(snapshot_path) << "1,2\n";
+    expectInvalid();
+
+    // A truncated snapshot.
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/cycle.td.csv", graph);
+    td.rootTree();
+    const FlatTreeDecomposition flat_td = FlatTreeDecomposition::nice(td);
+    Snapshot::save(snapshot_path, graph, flat_td);
+    std::filesystem::resize_file(snapshot_path, std::filesystem::file_size(snapshot_path) - 8);
+    expectInvalid();
+
+    // The parent of the last node is replaced by the node itself and by a node that does not exist. The parents are followed by the bag offsets and the bags, the last sections.
+    size_t bag_entries = 0;
+    for (const Node_Id n_id : flat_td.getPreOrder())
+        bag_entries += flat_td.getBag(n_id).size();
+    const uint64_t number_of_nodes = flat_td.numberOfNodes();
+    for (const uint64_t parent : {number_of_nodes - 1, number_of_nodes + 5}) {
+        Snapshot::save(snapshot_path, graph, flat_td);
+        {
+            std::fstream file(snapshot_path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-std::streamoff(sizeof(uint64_t) * (bag_entries + number_of_nodes + 2)), std::ios::end);
+            file.write(reinterpret_cast<const char*>(&parent), sizeof(parent));
+        }
+        expectInvalid();
+    }
+
+    std::filesystem::remove(snapshot_path);
+    return success;
+}
+
+int test_snapshot(int argc, char** argv) {
+    bool success = test_snapshot_round_trip();
+    success &= test_snapshot_not_nice();
+    success &= test_snapshot_invalid();
+    return !success;
+}
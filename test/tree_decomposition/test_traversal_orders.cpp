@@ -0,0 +1,81 @@
+#include "undirected_graph.h"
+#include "tree_decomposition.h"
+#include "util.h"
+
+#include <filesystem>
+#include <fstream>
+
+// Checks that both traversals visit every node exactly once, the pre-order each node before its children and the post-order after them.
+bool checkTraversalOrders(const TreeDecomposition& td, size_t number_of_nodes) {
+    std::vector<Node_Id> pre_order;
+    std::vector<Node_Id> post_order;
+    td.doSomethingPreOrder([&pre_order](Node_Id n_id) { pre_order.push_back(n_id); });
+    td.doSomethingPostOrder([&post_order](Node_Id n_id) { post_order.push_back(n_id); });
+
+    bool success = returnAndOutputOnFailure(number_of_nodes, pre_order.size());
+    success &= returnAndOutputOnFailure(number_of_nodes, post_order.size());
+    success &= returnAndOutputOnFailure(td.getRoot(), pre_order.front());
+    success &= returnAndOutputOnFailure(td.getRoot(), post_order.back());
+
+    std::unordered_set<Node_Id> visited;
+    for (const Node_Id n_id : pre_order) {
+        const std::optional<Node_Id> parent = td.getNode(n_id).parent;
+        success &= returnAndOutputOnFailure(true, !parent.has_value() || visited.contains(parent.value()));
+        visited.insert(n_id);
+    }
+    visited.clear();
+    for (const Node_Id n_id : post_order) {
+        for (const Node_Id child_id : td.getNode(n_id).children)
+            success &= returnAndOutputOnFailure(true, visited.contains(child_id));
+        visited.insert(n_id);
+    }
+    return success;
+}
+
+bool test_traversal_orders_unit_instances() {
+    bool success = true;
+    for (const std::string name : {"cycle", "house", "k4_plus_4_appendages", "sigma_graph"}) {
+        const std::string path = "test-instances/unit-test-instances/" + name;
+        UndirectedGraph graph = UndirectedGraph::parseUnsafe(path + ".gr.csv");
+        TreeDecomposition td = TreeDecomposition::parseUnsafe(path + ".td.csv", graph);
+        const size_t number_of_nodes = td.getAllNodeNames().size();
+        td.rootTree();
+        success &= checkTraversalOrders(td, number_of_nodes);
+
+        // Rerooting changes the orders.
+        const Node_Id other_root = td.getNode(td.getRoot()).children.empty() ? td.getRoot() : *td.getNode(td.getRoot()).children.begin();
+        td.rootTree(other_root);
+        success &= checkTraversalOrders(td, number_of_nodes);
+
+        td.turnIntoNiceTreeDecomposition();
+        success &= checkTraversalOrders(td, td.getAllNodeNames().size());
+    }
+    return success;
+}
+
+bool test_traversal_orders_deep() {
+    // The nice tree decomposition of a long path is a path of three times as many nodes, far deeper than a recursive traversal could go.
+    constexpr size_t length = 30000;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_traversal_orders_deep.gr.csv";
+    {
+        std::ofstream file{path};
+        for (size_t v = 0; v + 1 < length; v++)
+            file << v << "," << v + 1 << "\n";
+    }
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path);
+    std::filesystem::remove(path);
+
+    std::vector<Vertex_Id> ordering;
+    for (size_t v = 0; v < length; v++)
+        ordering.push_back(graph.nameToId(std::to_string(v)));
+    TreeDecomposition td = TreeDecomposition::fromEliminationOrdering(graph, ordering);
+    td.rootTree(td.nameToId("1"));
+    td.turnIntoNiceTreeDecomposition();
+    return checkTraversalOrders(td, td.getAllNodeNames().size());
+}
+
+int test_traversal_orders(int argc, char** argv) {
+    bool success = test_traversal_orders_unit_instances();
+    success &= test_traversal_orders_deep();
+    return !success;
+}
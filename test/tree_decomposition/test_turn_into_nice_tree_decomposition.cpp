@@ -31,6 +31,20 @@ bool test_medium() {
     return td.isNiceTreeDecomposition();
 }
 
+bool test_not_nice_below_root() {
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/cycle.gr.csv");
+    TreeDecomposition td = TreeDecomposition::parseUnsafe("test-instances/unit-test-instances/cycle_not_nice_below_root.td.csv", graph);
+
+    // The nodes down to N3 are nice, only N4, three levels below the root, introduces two vertices and forgets one.
+    td.rootTree(td.nameToId("N1"));
+    bool success = returnAndOutputOnFailure(true, td.isValid());
+    success &= returnAndOutputOnFailure(false, td.isNiceTreeDecomposition());
+
+    td.turnIntoNiceTreeDecomposition();
+    success &= returnAndOutputOnFailure(true, td.isNiceTreeDecomposition());
+    return success;
+}
+
 bool test_hard() {
     bool success = true;
     for (int i = 1; i < 1; i) {
@@ -53,6 +67,7 @@ int test_turn_into_nice_tree_decomposition(int argc, char** argv) {
     success &= test_hard();
     success &= test_medium();
     success &= test_easy();
+    success &= test_not_nice_below_root();
 
     return !success;
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "undirected_graph.h"
+#include "util.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+
+// Random graph with duplicate edges and self-loops on `n` vertices, checked against a set of its edges. Graphs with more than 8192 vertices have no adjacency matrix.
+bool testRandomGraph(size_t n, size_t number_of_edges) {
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<size_t> random_vertex(0, n - 1);
+    std::set<std::pair<size_t, size_t>> edges;
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_are_neighbours.gr.csv";
+    {
+        std::ofstream file{path};
+        for (size_t v = 0; v < n; v++)
+            file << v << ",," << 1 << "\n";
+        for (size_t i = 0; i < number_of_edges; i++) {
+            const size_t v = random_vertex(rng);
+            const size_t u = i % 10 == 0 ? v : random_vertex(rng);
+            file << v << "," << u << "\n";
+            if (i % 7 == 0)
+                file << u << "," << v << "\n";
+            edges.insert({v, u});
+            edges.insert({u, v});
+        }
+    }
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path);
+    std::filesystem::remove(path);
+
+    bool success = true;
+    for (size_t v = 0; v < n; v++) {
+        const Vertex_Id v_id = graph.nameToId(std::to_string(v));
+        const std::span<const Vertex_Id> neighbours = graph.getNeighbours(v_id);
+        success &= returnAndOutputOnFailure(true, std::is_sorted(neighbours.begin(), neighbours.end()));
+        success &= returnAndOutputOnFailure(true, std::adjacent_find(neighbours.begin(), neighbours.end()) == neighbours.end());
+
+        size_t degree = 0;
+        for (auto it = edges.lower_bound({v, 0}); it != edges.end() && it->first == v; it++) {
+            success &= returnAndOutputOnFailure(true, graph.areNeighbours(v_id, graph.nameToId(std::to_string(it->second))));
+            degree++;
+        }
+        success &= returnAndOutputOnFailure(degree, neighbours.size());
+    }
+    for (size_t i = 0; i < number_of_edges; i++) {
+        const size_t v = random_vertex(rng);
+        const size_t u = random_vertex(rng);
+        success &= returnAndOutputOnFailure(edges.contains({v, u}), graph.areNeighbours(graph.nameToId(std::to_string(v)), graph.nameToId(std::to_string(u))));
+    }
+    return success;
+}
+
+int test_are_neighbours(int argc, char** argv) {
+    bool success = testRandomGraph(100, 400);
+    success &= testRandomGraph(10000, 30000);
+    return !success;
+}
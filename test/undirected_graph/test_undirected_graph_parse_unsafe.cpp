@@ -1,6 +1,9 @@
 #include "undirected_graph.h"
 #include "util.h"
 
+#include <filesystem>
+#include <fstream>
+
 bool test_parse_unsafe_1() {
     UndirectedGraph graph = UndirectedGraph::parseUnsafe("test-instances/unit-test-instances/k5.gr.csv");
     bool success = returnAndOutputOnFailure((size_t)5, graph.numberOfNodes());
@@ -34,8 +37,109 @@ bool test_parse_unsafe_1() {
     return success;
 }
 
+bool test_parse_unsafe_numeric_names() {
+    // Numeric names (including ones that are not canonical integers) next to other names, with Windows line breaks.
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_parse_unsafe_numeric_names.gr.csv";
+    {
+        std::ofstream file{path};
+        file << "1,2\r\n2,100000000\r\n\r\n01,x\r\n1,,7\r\n01,,3\r\n100000000,,5\r\n";
+    }
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path);
+    std::filesystem::remove(path);
+
+    bool success = returnAndOutputOnFailure((size_t)5, graph.numberOfNodes());
+    success &= returnAndOutputOnFailure((size_t)3, graph.numberOfEdges());
+    success &= returnAndOutputOnFailure(std::string{"01"}, graph.idToName(graph.nameToId("01")));
+    success &= returnAndOutputOnFailure(7, graph.getWeight(graph.nameToId("1")));
+    success &= returnAndOutputOnFailure(3, graph.getWeight(graph.nameToId("01")));
+    success &= returnAndOutputOnFailure(5, graph.getWeight(graph.nameToId("100000000")));
+    success &= graph.areNeighbours(graph.nameToId("1"), graph.nameToId("2"));
+    success &= graph.areNeighbours(graph.nameToId("2"), graph.nameToId("100000000"));
+    success &= graph.areNeighbours(graph.nameToId("01"), graph.nameToId("x"));
+    success &= !graph.areNeighbours(graph.nameToId("1"), graph.nameToId("x"));
+
+    try {
+        graph.nameToId("3");
+        success = false;
+    }
+    catch (const std::invalid_argument&) {}
+
+    return success;
+}
+
+bool test_parse_unsafe_sparse_numeric_names() {
+    // 16000000 is too sparse for the dense table and hashed, also when it shows up again after smaller names.
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_parse_unsafe_sparse_numeric_names.gr.csv";
+    {
+        std::ofstream file{path};
+        file << "16000000,1\n2,16000000\n1,2\n16000000,,4\n";
+    }
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path);
+    std::filesystem::remove(path);
+
+    bool success = returnAndOutputOnFailure((size_t)3, graph.numberOfNodes());
+    success &= returnAndOutputOnFailure(4, graph.getWeight(graph.nameToId("16000000")));
+    success &= returnAndOutputOnFailure(std::string{"16000000"}, graph.idToName(graph.nameToId("16000000")));
+    success &= graph.areNeighbours(graph.nameToId("16000000"), graph.nameToId("2"));
+    success &= graph.areNeighbours(graph.nameToId("1"), graph.nameToId("2"));
+    return success;
+}
+
+bool test_parse_unsafe_weight_out_of_range() {
+    // Used to be read as an arbitrary weight instead of failing like std::stoi.
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_parse_unsafe_weight_out_of_range.gr.csv";
+    {
+        std::ofstream file{path};
+        file << "1,2\n1,,99999999999\n";
+    }
+    bool success = false;
+    try {
+        UndirectedGraph::parseUnsafe(path);
+    }
+    catch (const std::out_of_range&) {
+        success = true;
+    }
+    std::filesystem::remove(path);
+    return success;
+}
+
+bool test_parse_unsafe_pace() {
+    // The PACE files and the CSV files converted from them describe the same graphs (up to isolated vertices, which only the former contain) with the same ids.
+    bool success = true;
+    for (const std::string name : {"ex001", "ex004", "ex009"}) {
+        const std::string path = "test-instances/Treewidth-PACE-2017-Instances/" + name;
+        UndirectedGraph pace_graph = UndirectedGraph::parseUnsafe(path + ".gr");
+        UndirectedGraph csv_graph = UndirectedGraph::parseUnsafe(path + ".gr.csv");
+
+        success &= returnAndOutputOnFailure(csv_graph.getEdges(), pace_graph.getEdges());
+        success &= returnAndOutputOnFailure(true, pace_graph.numberOfNodes() >= csv_graph.numberOfNodes());
+        for (const Vertex_Id v_id : csv_graph.getVertices()) {
+            success &= returnAndOutputOnFailure(csv_graph.idToName(v_id), pace_graph.idToName(v_id));
+            success &= returnAndOutputOnFailure(csv_graph.getWeight(v_id), pace_graph.getWeight(v_id));
+        }
+    }
+
+    // Without the extension, the header decides.
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "test_parse_unsafe_pace.txt";
+    {
+        std::ofstream file{path};
+        file << "c a comment\np tw 4 2\n1 2\nc another comment\n2 3\n";
+    }
+    UndirectedGraph graph = UndirectedGraph::parseUnsafe(path);
+    std::filesystem::remove(path);
+    success &= returnAndOutputOnFailure((size_t)4, graph.numberOfNodes());
+    success &= returnAndOutputOnFailure((size_t)2, graph.numberOfEdges());
+    success &= returnAndOutputOnFailure(1, graph.getWeight(graph.nameToId("4")));
+
+    return success;
+}
+
 int test_undirected_graph_parse_unsafe(int argc, char** argv) {
     bool success = test_parse_unsafe_1();
+    success &= test_parse_unsafe_numeric_names();
+    success &= test_parse_unsafe_sparse_numeric_names();
+    success &= test_parse_unsafe_weight_out_of_range();
+    success &= test_parse_unsafe_pace();
     
     return !success;
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "util.h"
+
+#include <iostream>
+
+std::vector<std::string> tokens(std::string_view str, char delim) {
+    std::vector<std::string> parts;
+    forEachToken(str, delim, [&parts](std::string_view part) { parts.emplace_back(part); });
+    return parts;
+}
+
+bool test_for_each_token_like_string_split() {
+    bool success = true;
+    for (const std::string str : {"Hello, world, how are you doing, today?", "a,,20", "N1,N2,", ""})
+        success &= returnAndOutputOnFailure(stringSplit(str, ','), tokens(str, ','));
+    return success;
+}
+
+bool test_for_each_line() {
+    std::vector<std::string> lines;
+    forEachLine("a,b\r\n\nc,,1\n\r\nd;e", [&lines](std::string_view line) { lines.emplace_back(line); });
+    return returnAndOutputOnFailure(std::vector<std::string>{"a,b", "c,,1", "d;e"}, lines);
+}
+
+bool test_parse_number() {
+    bool success = returnAndOutputOnFailure(std::optional<size_t>{42}, parseNumber<size_t>("42"));
+    success &= returnAndOutputOnFailure(std::optional<int>{-7}, parseNumber<int>("-7"));
+    success &= returnAndOutputOnFailure(std::optional<size_t>{}, parseNumber<size_t>("4x"));
+    success &= returnAndOutputOnFailure(std::optional<size_t>{}, parseNumber<size_t>(""));
+    return success;
+}
+
+int test_for_each_token(int argc, char** argv) {
+    bool success = true;
+
+    success &= test_for_each_token_like_string_split();
+    success &= test_for_each_line();
+    success &= test_parse_number();
+
+    return !success;
+}